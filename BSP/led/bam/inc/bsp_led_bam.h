@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_bam.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's bit-angle modulation of many GPIO leds.
+ *
+ * Processing flow:
+ *
+ * led_bam_init() -> led_bam_level_set() per led output
+ *                -> led_bam_commit() once per engine tick
+ *                -> led_bam_isr() per timer interrupt.
+ *
+ * Bit b of the level of every led is shown for 2^b base periods, so one
+ * frame of LED_BAM_BITS interrupts gives every led its level out of
+ * 2^LED_BAM_BITS - 1, whatever the number of leds. The commit folds the
+ * levels into one BSRR word per bit per port, the bitplanes, so the ISR
+ * only stores LED_BAM_PORT_NUM words. The bitplanes are double buffered,
+ * the ISR takes the new ones at the start of a frame, so a frame never 
+ * mixes two commits.
+ *
+ * @version V1.0 2025-05-30
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_BAM_H__
+#define __BSP_LED_BAM_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Bits of the level, one interrupt per bit per frame                       */
+#ifndef LED_BAM_BITS
+#define LED_BAM_BITS                  (8U)
+#endif
+/* Level of full on                                                         */
+#define LED_BAM_LEVEL_MAX             ((1U << LED_BAM_BITS) - 1U)
+/* Ports driven by one engine                                               */
+#ifndef LED_BAM_PORT_NUM
+#define LED_BAM_PORT_NUM              (3U)
+#endif
+/* Leds driven by one engine                                                */
+#ifndef LED_BAM_CHANNEL_NUM
+#define LED_BAM_CHANNEL_NUM           (32U)
+#endif
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* Index of the port of the led in the engine      */
+    uint8_t                                        port;
+    /* Non-zero if the led is on at low level          */
+    uint8_t                                  active_low;
+    /* Pin of the led, GPIO_PIN_x                      */
+    uint16_t                                   pin_mask;
+} led_bam_channel_t;
+
+typedef struct
+{
+    /* BSRR register of every port, NULL if unused     */
+    volatile uint32_t            *p_bsrr[LED_BAM_PORT_NUM];
+    /* The leds, channel_num entries                   */
+    const led_bam_channel_t                 *p_channels;
+    uint32_t                                channel_num;
+    /* Level of every led                              */
+    uint16_t                  level[LED_BAM_CHANNEL_NUM];
+    /* Non-zero if a level changed since the commit    */
+    uint32_t                                      dirty;
+    /* Two frames of BSRR words per bit per port       */
+    volatile uint32_t planes[2][LED_BAM_BITS][LED_BAM_PORT_NUM];
+    /* Frame shown by the ISR                          */
+    volatile uint32_t                             front;
+    /* Non-zero if the other frame is to be shown      */
+    volatile uint32_t                      swap_request;
+    /* Bit shown by the next interrupt                 */
+    uint32_t                                        bit;
+} led_bam_t;
+
+/**
+ * @brief init the engine, every led is off.
+ *
+ * @param[out] p_bam       : The engine.
+ * @param[in]  p_bsrr      : BSRR register of every port, LED_BAM_PORT_NUM
+ *                           entries, NULL if unused.
+ * @param[in]  p_channels  : The leds, kept by the engine.
+ * @param[in]  channel_num : Number of the leds, up to LED_BAM_CHANNEL_NUM.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_bam_init(
+                                  led_bam_t          *const        p_bam,
+                                  volatile uint32_t  *const *const p_bsrr,
+                            const led_bam_channel_t  *const   p_channels,
+                            const uint32_t                   channel_num
+                         );
+
+/**
+ * @brief request the level of a led, nothing is shown before the commit.
+ *
+ * @param[in] p_bam       : The engine.
+ * @param[in] channel     : Index of the led.
+ * @param[in] level       : Level of the led, up to LED_BAM_LEVEL_MAX.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_bam_level_set(
+                                  led_bam_t          *const        p_bam,
+                            const uint32_t                       channel,
+                            const uint32_t                         level
+                              );
+
+/**
+ * @brief build the bitplanes of the levels requested and hand them to the
+ *        ISR, nothing is done if no level changed.
+ *
+ * @param[in] p_bam       : The engine.
+ *
+ * @return uint32_t : 1 if new bitplanes are handed to the ISR, else 0.
+ *
+ * */
+uint32_t led_bam_commit(led_bam_t *const p_bam);
+
+/**
+ * @brief show the bitplane of the next bit, called by the timer interrupt.
+ *
+ * @param[in] p_bam       : The engine.
+ *
+ * @return uint32_t : Weight of the bit shown, the time until the next 
+ *                    interrupt in base periods.
+ *
+ * */
+uint32_t led_bam_isr(led_bam_t *const p_bam);
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_BAM_H__
@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_bam.c
+ *
+ * @par dependencies
+ * - bsp_led_bam.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's bit-angle modulation of many GPIO leds.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-05-30
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_bam.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Bit offset of the reset bits in BSRR                                     */
+#define __BAM_BSRR_RESET_SHIFT        (16U)
+
+led_status_t led_bam_init(
+                                  led_bam_t          *const        p_bam,
+                                  volatile uint32_t  *const *const p_bsrr,
+                            const led_bam_channel_t  *const   p_channels,
+                            const uint32_t                   channel_num
+                         )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_bam || NULL == p_bsrr || NULL == p_channels ||
+         channel_num > LED_BAM_CHANNEL_NUM
+       )
+    {
+        DEBUG_OUT("Error: led_bam_init Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    for (uint32_t channel = 0; channel < channel_num; channel++)
+    {
+        if ( p_channels[channel].port >= LED_BAM_PORT_NUM     ||
+             NULL == p_bsrr[p_channels[channel].port]
+           )
+        {
+            DEBUG_OUT("Error: The port of the bam led is invalid!\r\n");
+            ret = LED_ERRORPARAMETER;
+            return ret;
+        }
+    }
+
+    for (uint32_t port = 0; port < LED_BAM_PORT_NUM; port++)
+    {
+        p_bam->p_bsrr[port] = p_bsrr[port];
+        for (uint32_t bit = 0; bit < LED_BAM_BITS; bit++)
+        {
+            p_bam->planes[0][bit][port] = 0;
+            p_bam->planes[1][bit][port] = 0;
+        }
+    }
+    for (uint32_t channel = 0; channel < LED_BAM_CHANNEL_NUM; channel++)
+    {
+        p_bam->level[channel] = 0;
+    }
+    p_bam->p_channels   =  p_channels;
+    p_bam->channel_num  = channel_num;
+    p_bam->front        =           0;
+    p_bam->swap_request =           0;
+    p_bam->bit          =           0;
+    p_bam->dirty        =           1;
+
+    // the leds are turned off by the first frame.
+    led_bam_commit(p_bam);
+
+    return ret;
+}
+
+led_status_t led_bam_level_set(
+                                  led_bam_t          *const        p_bam,
+                            const uint32_t                       channel,
+                            const uint32_t                         level
+                              )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_bam || channel >= p_bam->channel_num ||
+         level > LED_BAM_LEVEL_MAX
+       )
+    {
+        DEBUG_OUT("Error: led_bam_level_set Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    if ( level != p_bam->level[channel] )
+    {
+        p_bam->level[channel] = (uint16_t)level;
+        p_bam->dirty          =               1;
+    }
+
+    return ret;
+}
+
+uint32_t led_bam_commit(led_bam_t *const p_bam)
+{
+    uint32_t                 frame[LED_BAM_BITS][LED_BAM_PORT_NUM] = { { 0 } };
+    const led_bam_channel_t *p_channel = NULL;
+    uint32_t                 level     = 0;
+    uint32_t                 back      = 0;
+
+    if ( NULL == p_bam || 0 == p_bam->dirty )
+    {
+        return 0;
+    }
+    p_bam->dirty = 0;
+
+    // 1. fold the levels into the bitplanes, one or per bit per led.
+    for (uint32_t channel = 0; channel < p_bam->channel_num; channel++)
+    {
+        p_channel = &(p_bam->p_channels[channel]);
+        level     = p_bam->level[channel];
+        if ( 0 != p_channel->active_low )
+        {
+            level ^= LED_BAM_LEVEL_MAX;
+        }
+
+        for (uint32_t bit = 0; bit < LED_BAM_BITS; bit++)
+        {
+            frame[bit][p_channel->port] |= (0 != ((level >> bit) & 1U)) ?
+                (uint32_t)p_channel->pin_mask :
+                (uint32_t)p_channel->pin_mask << __BAM_BSRR_RESET_SHIFT;
+        }
+    }
+
+    // 2. the ISR keeps the frame it shows, so the other one is written.
+    p_bam->swap_request = 0;
+    back                = p_bam->front ^ 1U;
+    for (uint32_t bit = 0; bit < LED_BAM_BITS; bit++)
+    {
+        for (uint32_t port = 0; port < LED_BAM_PORT_NUM; port++)
+        {
+            p_bam->planes[back][bit][port] = frame[bit][port];
+        }
+    }
+    p_bam->swap_request = 1;
+
+    return 1;
+}
+
+uint32_t led_bam_isr(led_bam_t *const p_bam)
+{
+    uint32_t bit = p_bam->bit;
+
+    // a new frame starts, take the bitplanes of the last commit.
+    if ( 0 == bit && 0 != p_bam->swap_request )
+    {
+        p_bam->front        ^= 1U;
+        p_bam->swap_request  =  0;
+    }
+
+    for (uint32_t port = 0; port < LED_BAM_PORT_NUM; port++)
+    {
+        if ( NULL != p_bam->p_bsrr[port] )
+        {
+            *(p_bam->p_bsrr[port]) = p_bam->planes[p_bam->front][bit][port];
+        }
+    }
+
+    p_bam->bit = (bit + 1U < LED_BAM_BITS) ? (bit + 1U) : 0;
+
+    return 1U << bit;
+}
+//******************************** Defines **********************************//
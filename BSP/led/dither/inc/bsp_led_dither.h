@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_dither.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's temporal dithering of duties on a coarse output stage.
+ *
+ * Processing flow:
+ *
+ * led_dither_init() -> led_dither_duty_set() per led output
+ *                   -> led_dither_frame() once per frame of the output.
+ *
+ * The output stage shows a level out of level_max per frame, e.g. the 8
+ * bits of the bit-angle modulation. A first order sigma-delta carries the
+ * fraction of a level over to the next frames, so the mean of the levels
+ * is the duty to LED_DITHER_FRACTION_BITS more bits, e.g. 12 bits of
+ * brightness on the 8 bits of the BAM, and a dim fade near black moves by
+ * a fraction of the lowest level instead of jumping over it.
+ *
+ * The fraction is limited, so the pattern of levels repeats within
+ * 2^LED_DITHER_FRACTION_BITS frames and stays above the flicker a slower
+ * pattern would show. One frame costs an add, a shift and a mask per led.
+ *
+ * @version V1.0 2025-06-14
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_DITHER_H__
+#define __BSP_LED_DITHER_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Bits of a level spread over the frames, 1 to 16                          */
+#ifndef LED_DITHER_FRACTION_BITS
+#define LED_DITHER_FRACTION_BITS      (4U)
+#endif
+/* Leds of one dither stage                                                 */
+#ifndef LED_DITHER_CHANNEL_NUM
+#define LED_DITHER_CHANNEL_NUM        (32U)
+#endif
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* Level[Q of the fraction bits] of every led      */
+    volatile uint32_t        target[LED_DITHER_CHANNEL_NUM];
+    /* Fraction of a level carried to the next frame   */
+    uint16_t                  error[LED_DITHER_CHANNEL_NUM];
+    /* Number of the leds                              */
+    uint32_t                                   channel_num;
+    /* Level of full on of the output stage            */
+    uint32_t                                     level_max;
+} led_dither_t;
+
+/**
+ * @brief init the dither stage, every led is off.
+ *
+ * @param[out] p_dither    : The dither stage.
+ * @param[in]  channel_num : Number of the leds, up to LED_DITHER_CHANNEL_NUM.
+ * @param[in]  level_max   : Level of full on of the output, up to 0xFFFF.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_dither_init(
+                                  led_dither_t       *const     p_dither,
+                            const uint32_t                   channel_num,
+                            const uint32_t                     level_max
+                            );
+
+/**
+ * @brief set the duty of a led, it is taken by the next frame.
+ *
+ * The target is one word, so the frame may run in an ISR without a lock.
+ *
+ * @param[in] p_dither    : The dither stage.
+ * @param[in] channel     : Index of the led.
+ * @param[in] duty        : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_dither_duty_set(
+                                  led_dither_t       *const     p_dither,
+                            const uint32_t                       channel,
+                            const led_duty_t                        duty
+                                );
+
+/**
+ * @brief get the level of every led for the next frame of the output.
+ *
+ * @param[in]  p_dither    : The dither stage.
+ * @param[out] p_level     : Level of every led, channel_num entries.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_dither_frame(
+                                  led_dither_t       *const     p_dither,
+                                  uint16_t           *const      p_level
+                             );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_DITHER_H__
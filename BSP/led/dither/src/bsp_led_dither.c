@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_dither.c
+ *
+ * @par dependencies
+ * - bsp_led_dither.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's temporal dithering of duties on a coarse output stage.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-06-14
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_dither.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Mask of the fraction of a level                                          */
+#define __DITHER_FRACTION_MASK        ((1UL << LED_DITHER_FRACTION_BITS) - 1U)
+/* Error at the start, so a whole level is rounded to itself                */
+#define __DITHER_ERROR_HALF           (1UL << (LED_DITHER_FRACTION_BITS - 1U))
+
+led_status_t led_dither_init(
+                                  led_dither_t       *const     p_dither,
+                            const uint32_t                   channel_num,
+                            const uint32_t                     level_max
+                            )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_dither || channel_num > LED_DITHER_CHANNEL_NUM ||
+         0 == level_max   || level_max   > 0xFFFFU
+       )
+    {
+        DEBUG_OUT("Error: led_dither_init Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    for (uint32_t channel = 0; channel < LED_DITHER_CHANNEL_NUM; channel++)
+    {
+        p_dither->target[channel] =                    0;
+        p_dither->error[channel]  = __DITHER_ERROR_HALF;
+    }
+    p_dither->channel_num = channel_num;
+    p_dither->level_max   =   level_max;
+
+    return ret;
+}
+
+led_status_t led_dither_duty_set(
+                                  led_dither_t       *const     p_dither,
+                            const uint32_t                       channel,
+                            const led_duty_t                        duty
+                                )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_dither || channel >= p_dither->channel_num ||
+         duty >  LED_DUTY_FULL
+       )
+    {
+        DEBUG_OUT("Error: led_dither_duty_set Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    // the only multiply, once per change, the product fits in 32 bits.
+    p_dither->target[channel] = (duty * p_dither->level_max +
+                                 (0x8000UL >> LED_DITHER_FRACTION_BITS)) >>
+                                (16U - LED_DITHER_FRACTION_BITS);
+
+    return ret;
+}
+
+led_status_t led_dither_frame(
+                                  led_dither_t       *const     p_dither,
+                                  uint16_t           *const      p_level
+                             )
+{
+    led_status_t ret = LED_OK;
+    uint32_t     sum = 0;
+
+    if ( NULL == p_dither || NULL == p_level )
+    {
+        DEBUG_OUT("Error: led_dither_frame Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    // the whole levels are shown, the fraction left is shown later.
+    for (uint32_t channel = 0; channel < p_dither->channel_num; channel++)
+    {
+        sum                      = p_dither->error[channel] +
+                                   p_dither->target[channel];
+        p_level[channel]         = (uint16_t)(sum >>
+                                              LED_DITHER_FRACTION_BITS);
+        p_dither->error[channel] = (uint16_t)(sum & __DITHER_FRACTION_MASK);
+    }
+
+    return ret;
+}
+//******************************** Defines **********************************//
@@ -51,14 +51,14 @@ typedef enum
     LED_INITED         =    1,      /* LED initialized.                      */
 } led_driver_init_t;
 
-typedef enum
-{
-    PROPORTION_ON_OFF_1_1 =    0,   /* 1:1 proportion of on/off time.        */
-    PROPORTION_ON_OFF_1_2 =    1,   /* 1:2 proportion of on/off time.        */
-    PROPORTION_ON_OFF_1_3 =    2,   /* 1:3 proportion of on/off time.        */
-    PROPORTION_ON_OFF_NUM       ,   /* Number of proportion types.           */
-    PROPORTION_ON_OFF_x_x = 0xFF,   /* Reserved.                             */
-} proportion_t;
+/* Duty of the on time, an unsigned Q16 fraction of one cycle.              */
+typedef uint32_t led_duty_t;
+
+/* One op of a blink pattern bytecode, see bsp_led_pattern.h.                */
+typedef uint16_t led_pattern_op_t;
+
+/* A keyframe timeline in flash, see bsp_led_timeline.h.                     */
+typedef struct led_timeline_s led_timeline_t;
 
 typedef enum
 {
@@ -69,9 +69,56 @@ typedef enum
     LED_ERRORPARAMETER    =    4,   /* Parameter error.                      */
     LED_ERRORNOMEMORY     =    5,   /* Out of memory.                        */
     LED_ERRORISR          =    6,   /* Not allowed in ISR context            */
+    LED_ERRORCANCELLED    =    7,   /* Replaced by a newer command           */
     LED_STATUS_NUM              ,   /* Number of led status                  */
     LED_RESERVED          = 0xFF,   /* Reserved                              */
 } led_status_t;
+
+typedef enum
+{
+    LED_PHASE_IDLE        =    0,   /* No blink in progress.                 */
+    LED_PHASE_ON          =    1,   /* On part of the current cycle.         */
+    LED_PHASE_OFF         =    2,   /* Off part of the current cycle.        */
+    LED_PHASE_HW          =    3,   /* Blink sequence offloaded to hardware. */
+    LED_PHASE_WAVE        =    4,   /* Duty frames of a wave shape.          */
+    LED_PHASE_PATTERN     =    5,   /* Ops of a pattern bytecode.            */
+    LED_PHASE_RAMP        =    6,   /* Ramp op of a pattern in progress.     */
+    LED_PHASE_TIMELINE    =    7,   /* Keyframes of a timeline in flash.     */
+} led_phase_t;
+
+typedef enum
+{
+    LED_WAVE_SQUARE       =    0,   /* On/off blink of the duty.             */
+    LED_WAVE_SINE         =    1,   /* Sine breathing up to the peak duty.   */
+    LED_WAVE_TRIANGLE     =    2,   /* Linear ramp up and down.              */
+    LED_WAVE_EXP          =    3,   /* Exponential fade from the peak duty.  */
+    LED_WAVE_NUM                ,   /* Number of wave shapes.                */
+} led_wave_shape_t;
+
+/* Full scale of the duty, duty is an unsigned Q16 fraction of the period.   */
+#define LED_DUTY_FULL            (0x10000UL)
+/* Period[us] of the duty-cycle backend while dimming, flicker free.         */
+#define LED_DIM_PERIOD_US        (1000UL)
+/* Reserved duty, out of range on purpose.                                   */
+#define LED_DUTY_INVALID         (0xFFFFFFFFUL)
+
+/* Duty of an on:off ratio, folded at compile time for constant operands.    */
+#define LED_DUTY_RATIO(on, off)                                               \
+    ((led_duty_t)(((uint32_t)(on) * LED_DUTY_FULL) /                          \
+                  ((uint32_t)(on) + (uint32_t)(off))))
+#define LED_DUTY_1_1             LED_DUTY_RATIO(1, 1) /* 1:1 of on/off time. */
+#define LED_DUTY_1_2             LED_DUTY_RATIO(1, 2) /* 1:2 of on/off time. */
+#define LED_DUTY_1_3             LED_DUTY_RATIO(1, 3) /* 1:3 of on/off time. */
+
+/* Wrap-safe check that time base a is earlier than time base b.             */
+#define LED_TIME_BEFORE(a, b)    ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+/* The blink engine runs on a time base[us], the commands may be in ms.      */
+#define LED_US_PER_MS            (1000UL)
+/* Bound[us] of the cycle of a blink, 10 s, the bound itself is refused.   */
+#define LED_CYCLE_US_MAX         (10000UL * LED_US_PER_MS)
+/* Longest wait[us] scheduled at once, well within the wrap-safe half of 
+   the time base, longer sequences are rescheduled on the way.               */
+#define LED_TIME_SPAN_MAX_US     (0x40000000UL)
 //******************************** Defines **********************************//
 
 
@@ -93,6 +140,28 @@ typedef struct
 {
     led_status_t (*pf_led_on)  (void); /* Function to turn the LED on        */
     led_status_t (*pf_led_off) (void); /* Function to turn the LED off       */
+    /*
+    Optional duty-cycle backend, e.g. a timer PWM channel, NULL if absent.
+    When both are mounted, periodic blinks are offloaded to the hardware.
+    */
+    /* Function to set the duty[Q16 of LED_DUTY_FULL]                        */
+    led_status_t (*pf_led_set_duty)   (const uint32_t);
+    /* Function to set the period[us] of one cycle                           */
+    led_status_t (*pf_led_set_period) (const uint32_t);
+    /*
+    Optional write-coalescing backend, e.g. a GPIO port shadow, NULL if the
+    on/off functions drive the pins at once. pf_led_on/pf_led_off only 
+    request the level, it is stored by one call after the engine tick.
+    */
+    /* Function to store the levels requested since the last call            */
+    led_status_t (*pf_led_flush)      (void);
+    /*
+    Optional cycle counter of the duty-cycle backend, NULL if absent. The
+    hardware stops by itself at the end of the given number of cycles, so
+    a late engine never lets one more pulse through.
+    */
+    /* Function to turn the output off after a number of cycles              */
+    led_status_t (*pf_led_set_count)  (const uint32_t);
 } led_operations_t;
 
 typedef struct
@@ -105,35 +174,133 @@ typedef struct
     led_status_t (*pf_get_time_base_mm) (uint32_t *const); 
 } time_base_t;
 
+typedef struct
+{
+    /* Current phase of the blink state machine        */
+    led_phase_t                                    phase;
+    /* Time base[us] at which the next edge is due, 
+       the end of the command once the engine is idle  */
+    uint32_t                                next_edge_us;
+    /* Time base[us] at which the first cycle starts, 
+       every edge is counted from it                   */
+    uint32_t                                    epoch_us;
+    /* On time of one cycle[us], computed on start     */
+    uint32_t                                  on_time_us;
+    /* Off time of one cycle[us], computed on start    */
+    uint32_t                                 off_time_us;
+    /* Cycles left after the current one               */
+    uint32_t                             blink_remaining;
+    /* Time base[us] at which the current wave cycle
+       or the ramp starts                              */
+    uint32_t                               wave_start_us;
+    /* Time base[us] at which the ramp ends            */
+    uint32_t                                 wave_end_us;
+    /* Phase[Q32 of cycle] advanced by one microsecond */
+    uint32_t                             wave_phase_step;
+    /* Pattern in flash played by LED_PHASE_PATTERN    */
+    const led_pattern_op_t                    *p_pattern;
+    /* Index of the next op of the pattern             */
+    uint16_t                                  pattern_pc;
+    /* Plays left of the REPEAT block, 0 if none       */
+    uint16_t                              pattern_repeat;
+    /* Level[Q16 of 0..255] shown by the pattern       */
+    int32_t                                pattern_level;
+    /* Level[Q16] at which the ramp starts             */
+    int32_t                                    ramp_from;
+    /* Level[Q16] at which the ramp ends               */
+    int32_t                                      ramp_to;
+    /* Level[Q16] changed by one millisecond of ramp   */
+    int32_t                                    ramp_step;
+    /* Timeline in flash played by LED_PHASE_TIMELINE  */
+    const led_timeline_t                     *p_timeline;
+    /* Index of the keyframe the position is after     */
+    uint32_t                                timeline_key;
+    /* Position[ms] in the timeline at wave_start_us,
+       kept when the timeline is paused                */
+    uint32_t                             timeline_pos_ms;
+    /* Duty last written to the led, on is full duty   */
+    led_duty_t                               output_duty;
+} led_blink_state_t;
+
+#ifdef OS_SUPPORTING
+typedef void (*pf_led_done_t) (
+                              bsp_led_driver_t *const, //  Pointer to the led
+                        const led_status_t           , //  Result of the blink
+                              void             *const  //  Argument of caller
+                              );
+
+typedef struct
+{
+    /* Called in the worker thread when the blink ends, NULL allowed         */
+    pf_led_done_t                                  pf_done;
+    /* Argument passed to pf_done                                            */
+    void                                            *p_arg;
+    /* CMSIS-RTOS2 osEventFlagsId_t set when the blink ends, NULL allowed    */
+    void                                    *p_event_flags;
+    /* Flags set in p_event_flags                                            */
+    uint32_t                                         flags;
+} led_completion_t;
+
+typedef led_status_t (*pf_led_submit_t) (
+                              void             *const, //  Owner of the led
+                              bsp_led_driver_t *const, //  Pointer to the led
+                        const uint32_t               , //     Cycle time[ms]
+                        const uint32_t               , // Blink times[times]
+                        const led_duty_t             , //  Duty[Q16]
+                        const led_completion_t *const  //  Completion or NULL
+                                        );
+
 typedef led_status_t (*pf_led_control_t) (
                               bsp_led_driver_t *const, //  Pointer to itself
                         const uint32_t               , //     Cycle time[ms]
                         const uint32_t               , // Blink times[times]
-                        const proportion_t             //  proportion_on_off
+                        const led_duty_t             , //  Duty[Q16]
+                        const led_completion_t *const  //  Completion or NULL
                                          );
+#else
+typedef led_status_t (*pf_led_control_t) (
+                              bsp_led_driver_t *const, //  Pointer to itself
+                        const uint32_t               , //     Cycle time[ms]
+                        const uint32_t               , // Blink times[times]
+                        const led_duty_t               //  Duty[Q16]
+                                         );
+#endif // End of OS_SUPPORTING
 typedef struct bsp_led_driver_s
 {
     /******************Target of Status*****************/
     // TBD: need lock
     led_driver_init_t                          is_inited;
     /**********Target of enternal requirements**********/
-    /* The whole time of blink                         */
-    uint32_t                               cycle_time_ms;
+    /* The whole time of one cycle[us]                 */
+    uint32_t                               cycle_time_us;
     /* The times of blink                              */
     uint32_t                                 blink_times;
-    /* The proportion ralationship of light on and off */
-    proportion_t                       proportion_on_off;
+    /* The duty of light on, Q16 of LED_DUTY_FULL,
+       it is the peak duty of the wave shapes          */
+    led_duty_t                                      duty;
+    /* The shape of the brightness in one cycle        */
+    led_wave_shape_t                               shape;
+
+    /******************Target of runtime data***********/
+    /* The state machine of the blink engine           */
+    led_blink_state_t                        blink_state;
 
     /***************Target of internal IOs**************/
 #ifdef OS_SUPPORTING
     /* The APIs from OS layer                          */
     const os_delay_t                         *p_os_delay;
+    /* The handler which the led is registered to      */
+    void                                        *p_owner;
+    /* The API of the owner to post a blink request    */
+    pf_led_submit_t                            pf_submit;
 #endif // End of OS_SUPPORTING
     /* The APIs from Core layer                        */
     const led_operations_t                   *p_led_opes;
     const time_base_t                       *p_time_base;
 
     /**************Target of enternal APIs**************/
+    /* Blocking with no OS, else it posts the request  
+       to the owner handler and returns immediately    */
     pf_led_control_t                    pf_led_controler;
 
 } bsp_led_driver_t;
@@ -163,6 +330,141 @@ led_status_t led_driver_inst(
                             const led_operations_t   *const   led_ops,
                             const time_base_t        *const time_base
                             );
+
+/**
+ * @brief calculate the on time of one cycle from the duty.
+ * 
+ * It costs one multiply and one shift, called once per command.
+ *  
+ * @param[in]  cycle_time        : The whole time of one cycle, in any unit.
+ * @param[in]  duty              : The duty of led on, Q16 of LED_DUTY_FULL.
+ * @param[out] p_on_time         : The on time of one cycle, in that unit.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_on_time_calc(
+                            const uint32_t                 cycle_time,
+                            const led_duty_t                     duty,
+                                  uint32_t   *const         p_on_time
+                                    );
+
+/**
+ * @brief arm the blink engine of the target with its requirement values.
+ * 
+ * Steps:
+ * 1. precompute the on/off time of one cycle.
+ * 2. turn the led on and set the deadline of the first edge.
+ * 
+ * Every edge is the epoch plus a whole number of cycles, so a train of
+ * any length holds its period, however late the ticks are.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] now_us      : Epoch[us] of the first cycle, the current time
+ *                          base or the end of the command played before.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_blink_start(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us
+                                   );
+
+/**
+ * @brief advance the blink engine of the target to the time base now_us.
+ * 
+ * Only the edges whose deadline has expired are processed, and the led
+ * output is written once per call at most.
+ *  
+ * @param[in]  self           : Pointer to the target of driver.
+ * @param[in]  now_us         : Current time base[us].
+ * @param[out] p_next_edge_us : Deadline of the next edge, NULL allowed. 
+ *                              Only valid while the engine is not idle.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_blink_tick(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us,
+                                  uint32_t           *const p_next_edge_us
+                                  );
+
+/**
+ * @brief get the next boundary at which the running command of the target
+ *        could be replaced without a runt pulse.
+ *  
+ * @param[in]  self           : Pointer to the target of driver.
+ * @param[in]  now_us         : Current time base[us].
+ * @param[in]  at_cycle_end   : 1 to wait for the end of the cycle, else 0.
+ * @param[out] p_boundary_us  : Time base[us] of the boundary.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_boundary_get(
+                            const bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us,
+                            const uint32_t               at_cycle_end,
+                                  uint32_t           *const p_boundary_us
+                                    );
+
+/**
+ * @brief stop the blink engine of the target and leave the led off.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] end_us      : Time base[us] kept as the end of the command, 
+ *                          the epoch of the command played next.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_blink_cancel(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     end_us
+                                    );
+
+/**
+ * @brief set the perceptual brightness of the target through its 
+ *        duty-cycle backend, the level is gamma corrected by table.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] level       : Brightness level, 0 is off and 255 is full on.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_brightness_set(
+                                  bsp_led_driver_t   *const      self,
+                            const uint8_t                       level
+                                      );
+
+/**
+ * @brief write a duty to the led of the target, on or off on a backend
+ *        without duty-cycle, and keep it as the output of the target.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] duty        : Duty to be shown.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_level_write(
+                                  bsp_led_driver_t   *const      self,
+                            const led_duty_t                     duty
+                                   );
+
+/**
+ * @brief set the flicker free period LED_DIM_PERIOD_US on a duty-cycle
+ *        backend of the target, before it dims.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_dim_period_set(bsp_led_driver_t *const self);
 //******************************** Declaring ********************************//
 
 #endif // End of __BSP_LED_DRIVER_H__
@@ -7,6 +7,10 @@
  *
  * @par dependencies
  * - bsp_led_driver.h
+ * - bsp_led_gamma.h
+ * - bsp_led_wave.h
+ * - bsp_led_pattern.h
+ * - bsp_led_timeline.h
  *
  * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
  *
@@ -25,27 +29,300 @@
 
 //******************************** Includes *********************************//
 #include "bsp_led_driver.h"
+#include "bsp_led_gamma.h"
+#include "bsp_led_wave.h"
+#include "bsp_led_pattern.h"
+#include "bsp_led_timeline.h"
 //******************************** Includes *********************************//
 
 
 //******************************** Defines **********************************//
-#ifndef OS_SUPPORTING
 /**
- * @brief 
+ * @brief write the led output of the target.
+ *  
+ * @param[in] self             : Pointer to the target of driver.
+ * @param[in] phase            : The phase that the output should show.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+static led_status_t __led_output(
+                            bsp_led_driver_t *const  self,
+                      const led_phase_t             phase
+                                )
+{
+    if (LED_PHASE_ON == phase)
+    {
+        self->blink_state.output_duty = LED_DUTY_FULL;
+        return self->p_led_opes->pf_led_on();
+    }
+
+    self->blink_state.output_duty = 0;
+    return self->p_led_opes->pf_led_off();
+}
+
+/**
+ * @brief calculate the on time of one cycle from the duty.
+ * 
+ * It costs one multiply and one shift, called once per command.
+ *  
+ * @param[in]  cycle_time        : The whole time of one cycle, in any unit.
+ * @param[in]  duty              : The duty of led on, Q16 of LED_DUTY_FULL.
+ * @param[out] p_on_time         : The on time of one cycle, in that unit.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_on_time_calc(
+                            const uint32_t                 cycle_time,
+                            const led_duty_t                     duty,
+                                  uint32_t   *const         p_on_time
+                                    )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_on_time )
+    {
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    if ( LED_DUTY_FULL < duty )
+    {
+        DEBUG_OUT("Error: The duty is out of range!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    // the 64-bit product is a single UMULL on Cortex-M4, no division.
+    // round to nearest, so that e.g. LED_DUTY_1_2 of 3 ms gives 1 ms.
+    *p_on_time = (uint32_t)(((uint64_t)cycle_time * duty + 
+                             (LED_DUTY_FULL >> 1)) >> 16);
+
+    return ret;
+}
+
+/**
+ * @brief get the time base at which the current cycle started.
+ * 
+ * The edges are not summed up from the previous one, the number of cycles
+ * played is multiplied from the epoch, so no error is carried over.
+ *  
+ * @param[in] self             : Pointer to the target of driver.
+ * 
+ * @return uint32_t : Time base[us] of the start of the current cycle.
+ * 
+ * */
+static uint32_t __led_cycle_start_us(const bsp_led_driver_t *const self)
+{
+    // the product wraps like the time base, the deadlines stay right.
+    return self->blink_state.epoch_us +
+           (self->blink_times - 1 - self->blink_state.blink_remaining) *
+                                                   self->cycle_time_us;
+}
+
+/**
+ * @brief move the deadline of the hardware blink over as many cycles as 
+ *        fit in LED_TIME_SPAN_MAX_US, up to the end of the last on time.
+ *  
+ * @param[in] self             : Pointer to the target of driver.
+ * 
+ * */
+static void __led_hw_schedule(bsp_led_driver_t *const self)
+{
+    led_blink_state_t *p_state = &(self->blink_state);
+    uint32_t           cycles  = LED_TIME_SPAN_MAX_US / self->cycle_time_us;
+
+    if ( cycles > p_state->blink_remaining )
+    {
+        cycles = p_state->blink_remaining;
+    }
+
+    p_state->blink_remaining -=                           cycles;
+    p_state->next_edge_us     =         __led_cycle_start_us(self);
+    if ( 0 == p_state->blink_remaining )
+    {
+        p_state->next_edge_us += p_state->on_time_us;
+    }
+}
+
+/**
+ * @brief offload a whole blink sequence to the duty-cycle backend.
+ * 
+ * The period and duty are programmed once, the engine only keeps the 
+ * deadline at which the last on time is over to stop the hardware. A
+ * backend with a cycle counter stops by itself after the last cycle, the
+ * deadline then only ends the command.
+ *  
+ * @param[in] self             : Pointer to the target of driver.
+ * @param[in] now_us           : Current time base[us].
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+static led_status_t __led_hw_start(
+                            bsp_led_driver_t *const   self,
+                      const uint32_t                now_us
+                                  )
+{
+    led_status_t       ret     = LED_OK;
+    led_blink_state_t *p_state = &(self->blink_state);
+
+    // the duty goes first, the new period restarts the first cycle with it.
+    p_state->output_duty  =   self->duty;
+    ret = self->p_led_opes->pf_led_set_duty(self->duty);
+    if (LED_OK != ret)
+    {
+        return ret;
+    }
+    // the period is in us, so sub-millisecond cycles are exact here.
+    ret = self->p_led_opes->pf_led_set_period(self->cycle_time_us);
+    if (LED_OK != ret)
+    {
+        return ret;
+    }
+    if ( NULL != self->p_led_opes->pf_led_set_count )
+    {
+        ret = self->p_led_opes->pf_led_set_count(self->blink_times);
+        if (LED_OK != ret)
+        {
+            return ret;
+        }
+    }
+
+    p_state->phase        = LED_PHASE_HW;
+    p_state->epoch_us     =       now_us;
+    __led_hw_schedule(self);
+
+    return ret;
+}
+
+/**
+ * @brief write the duty frame of the wave at the time base now_us.
+ * 
+ * Frames missed while the caller was late are skipped, not replayed, and
+ * the led is left dark once the last cycle is over.
+ *  
+ * @param[in] self             : Pointer to the target of driver.
+ * @param[in] now_us           : Current time base[us].
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+static led_status_t __led_wave_tick(
+                            bsp_led_driver_t *const   self,
+                      const uint32_t                now_us
+                                   )
+{
+    led_blink_state_t *p_state  = &(self->blink_state);
+    led_duty_t         duty     = 0;
+    uint32_t           cycle_us = self->cycle_time_us;
+    uint32_t           cycle_end_us;
+
+    // 1. the start follows the cycles, so the phase never sees a wrap of
+    //    the time base, whatever the length of the whole wave.
+    while ( (now_us - p_state->wave_start_us) >= cycle_us )
+    {
+        if ( 0 == p_state->blink_remaining )
+        {
+            p_state->phase       = LED_PHASE_IDLE;
+            p_state->output_duty =              0;
+            return self->p_led_opes->pf_led_set_duty(0);
+        }
+        p_state->blink_remaining--;
+        p_state->wave_start_us += cycle_us;
+    }
+
+    duty = led_wave_sample(self->shape,
+                           (now_us - p_state->wave_start_us) *
+                                     p_state->wave_phase_step,
+                           self->duty);
+
+    // 2. the last frame of a cycle is due at its end.
+    cycle_end_us          = p_state->wave_start_us + cycle_us;
+    p_state->next_edge_us = now_us + LED_WAVE_FRAME_MS * LED_US_PER_MS;
+    if ( !LED_TIME_BEFORE(p_state->next_edge_us, cycle_end_us) )
+    {
+        p_state->next_edge_us = cycle_end_us;
+    }
+
+    p_state->output_duty = duty;
+    return self->p_led_opes->pf_led_set_duty(duty);
+}
+
+/**
+ * @brief play the wave shape of the target as duty frames.
+ * 
+ * The phase step holds the only division of the wave, every frame then
+ * costs one multiply and a table lookup.
+ *  
+ * @param[in] self             : Pointer to the target of driver.
+ * @param[in] now_us           : Current time base[us].
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+static led_status_t __led_wave_start(
+                            bsp_led_driver_t *const   self,
+                      const uint32_t                now_us
+                                    )
+{
+    led_status_t       ret     = LED_OK;
+    led_blink_state_t *p_state = &(self->blink_state);
+
+    if ( LED_WAVE_NUM <= self->shape )
+    {
+        DEBUG_OUT("Error: The wave shape is invalid!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    if ( NULL == self->p_led_opes->pf_led_set_duty )
+    {
+        DEBUG_OUT("Error: The led has no duty-cycle backend!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    ret = led_driver_dim_period_set(self);
+    if (LED_OK != ret)
+    {
+        return ret;
+    }
+
+    p_state->wave_phase_step = led_wave_step_calc(self->cycle_time_us);
+    p_state->epoch_us        =                                   now_us;
+    p_state->wave_start_us   =                                   now_us;
+    p_state->blink_remaining =                    self->blink_times - 1;
+    p_state->phase           =                           LED_PHASE_WAVE;
+
+    return __led_wave_tick(self, now_us);
+}
+
+/**
+ * @brief arm the blink engine of the target with its requirement values.
  * 
  * Steps:
- * 1. analyze the target's parameters.
- * 2. run the operation of led.
+ * 1. precompute the on/off time of one cycle.
+ * 2. turn the led on and set the deadline of the first edge.
+ * 
+ * Every edge is the epoch plus a whole number of cycles, so a train of
+ * any length holds its period, however late the ticks are.
  *  
- * @param[in] self             : Pointer to the target of handler.
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] now_us      : Epoch[us] of the first cycle, the current time
+ *                          base or the end of the command played before.
  * 
- * @return led_handler_status_t : Status of the function.
+ * @return led_status_t : Status of the function.
  * 
  * */
-static led_status_t led_blink(bsp_led_driver_t *const self) 
+led_status_t led_driver_blink_start(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us
+                                   )
 {
     led_status_t ret = LED_OK;
-    DEBUG_OUT("Info: Enter led_blink!\r\n");
+    DEBUG_OUT("Info: Enter led_driver_blink_start!\r\n");
 
     // 1. check if the target has been initialized.
     if (
@@ -58,63 +335,500 @@ static led_status_t led_blink(bsp_led_driver_t *const self)
         return ret;
     }
 
+    // 2. calculate the on time of led from the duty.
+    uint32_t     led_toggle_time         =              0x5a5a5a5a;
+    ret = led_driver_on_time_calc(self->cycle_time_us,
+                                  self->duty         ,
+                                  &led_toggle_time   );
+    if (LED_OK != ret)
+    {
+        return ret;
+    }
+
+    if (0 == self->blink_times)
+    {
+        DEBUG_OUT("Error: The blink times is zero!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    if ( 0                == self->cycle_time_us ||
+         LED_CYCLE_US_MAX <= self->cycle_time_us
+       )
+    {
+        DEBUG_OUT("Error: The cycle time is out of range!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    // 2-1. the wave shapes are played as duty frames, not edges.
+    if (LED_WAVE_SQUARE != self->shape)
     {
-        // 2. analyze the target's parameters.
-        // 2-1. save target's parameters to local variables.
-        uint32_t     cycle_time_local        =     self->cycle_time_ms;
-        uint32_t     blink_times_total       =       self->blink_times;
-        proportion_t proportion_on_off_local = self->proportion_on_off;
-        
-        // 2-2. calculate the proportion time of led on and off.
-        uint32_t     led_toggle_time         =              0x5a5a5a5a;
-        switch (proportion_on_off_local)
+        return __led_wave_start(self, now_us);
+    }
+
+    // 3. start the first cycle.
+    led_blink_state_t *p_state = &(self->blink_state);
+    p_state->on_time_us      =                      led_toggle_time;
+    p_state->off_time_us     = self->cycle_time_us - led_toggle_time;
+    p_state->blink_remaining =               self->blink_times - 1;
+    p_state->phase           =                         LED_PHASE_ON;
+    p_state->epoch_us        =                               now_us;
+    p_state->next_edge_us    =            now_us + led_toggle_time;
+
+    // 3-1. let the hardware produce the edges if the backend supports it.
+    if ( NULL != self->p_led_opes->pf_led_set_duty   &&
+         NULL != self->p_led_opes->pf_led_set_period
+       )
+    {
+        return __led_hw_start(self, now_us);
+    }
+
+    if (0 != p_state->on_time_us)
+    {
+        ret = __led_output(self, LED_PHASE_ON);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief advance the blink engine of the target to the time base now_us.
+ * 
+ * Only the edges whose deadline has expired are processed, and the led
+ * output is written once per call at most.
+ *  
+ * @param[in]  self           : Pointer to the target of driver.
+ * @param[in]  now_us         : Current time base[us].
+ * @param[out] p_next_edge_us : Deadline of the next edge, NULL allowed. 
+ *                              Only valid while the engine is not idle.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_blink_tick(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us,
+                                  uint32_t           *const p_next_edge_us
+                                  )
+{
+    led_status_t       ret     = LED_OK;
+    led_blink_state_t *p_state = NULL;
+    led_phase_t        phase_before;
+
+    if (
+        NULL     == self                  ||
+        LED_NOT_INITED == self->is_inited
+       )
+    {
+        DEBUG_OUT("Error: The driver has not been initialized!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    p_state      = &(self->blink_state);
+    phase_before = p_state->phase;
+
+    // 0. a wave writes one duty frame per expired deadline.
+    if (LED_PHASE_WAVE == p_state->phase)
+    {
+        if ( !LED_TIME_BEFORE(now_us, p_state->next_edge_us) )
         {
-            case PROPORTION_ON_OFF_1_1:
-                led_toggle_time = cycle_time_local / 2;
-                break;
-            case PROPORTION_ON_OFF_1_2:
-                led_toggle_time = cycle_time_local / 3;
-                break;
-            case PROPORTION_ON_OFF_1_3:
-                led_toggle_time = cycle_time_local / 4;
-                break;
-            default:
-                DEBUG_OUT("\
-                    calculate the proportion time of led on and off failed!\r\n");
-                ret = LED_ERRORPARAMETER;
-                return ret;
+            ret = __led_wave_tick(self, now_us);
         }
+        if ( NULL != p_next_edge_us )
+        {
+            *p_next_edge_us = p_state->next_edge_us;
+        }
+        return ret;
+    }
 
-        // 3. run the operation of led.
-        for (
-             uint32_t blink_number = 0; 
-             blink_number < blink_times_total; 
-             ++ blink_number
-            ) 
+    // 0-1. a pattern runs its ops in the interpreter.
+    if ( LED_PHASE_PATTERN == p_state->phase ||
+         LED_PHASE_RAMP    == p_state->phase
+       )
+    {
+        ret = led_pattern_tick(self, now_us);
+        if ( NULL != p_next_edge_us )
         {
-            for (
-                uint32_t start_cycyle_time = 0;
-                start_cycyle_time < cycle_time_local;
-                ++ start_cycyle_time
-                )
+            *p_next_edge_us = p_state->next_edge_us;
+        }
+        return ret;
+    }
+
+    // 0-2. a timeline writes one frame of its keyframes per deadline.
+    if ( LED_PHASE_TIMELINE == p_state->phase )
+    {
+        ret = led_timeline_tick(self, now_us);
+        if ( NULL != p_next_edge_us )
+        {
+            *p_next_edge_us = p_state->next_edge_us;
+        }
+        return ret;
+    }
+
+    // 1. process every edge whose deadline has expired.
+    while ( LED_PHASE_IDLE != p_state->phase                       &&
+            !LED_TIME_BEFORE(now_us, p_state->next_edge_us)
+          )
+    {
+        if (LED_PHASE_HW == p_state->phase)
+        {
+            // a long sequence is only part way, wait for the next part.
+            if (0 != p_state->blink_remaining)
             {
-                if (start_cycyle_time >= led_toggle_time)
-                {
-                    self->p_led_opes->pf_led_off();
-                }
-                else
-                {
-                    self->p_led_opes->pf_led_on();
-                }
+                __led_hw_schedule(self);
+                continue;
             }
+            // the last on time is over, stop the hardware in the off time,
+            // the command ends with its last cycle.
+            p_state->phase         =               LED_PHASE_IDLE;
+            p_state->output_duty   =                            0;
+            p_state->next_edge_us  = __led_cycle_start_us(self) + 
+                                                 self->cycle_time_us;
+            ret = self->p_led_opes->pf_led_set_duty(0);
+            return ret;
+        }
+        else if (LED_PHASE_ON == p_state->phase)
+        {
+            p_state->phase         =                LED_PHASE_OFF;
+            p_state->next_edge_us  = __led_cycle_start_us(self) +
+                                                 self->cycle_time_us;
+        }
+        else if (0 != p_state->blink_remaining)
+        {
+            p_state->blink_remaining--;
+            p_state->phase         =                 LED_PHASE_ON;
+            p_state->next_edge_us  = __led_cycle_start_us(self) +
+                                                  p_state->on_time_us;
+        }
+        else
+        {
+            p_state->phase         =               LED_PHASE_IDLE;
         }
     }
 
+    // 2. write the output only if the level of led has changed.
+    if ( (LED_PHASE_ON == phase_before) != (LED_PHASE_ON == p_state->phase) )
+    {
+        ret = __led_output(self, p_state->phase);
+    }
+
+    if ( NULL != p_next_edge_us )
+    {
+        *p_next_edge_us = p_state->next_edge_us;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief get the next boundary at which the running command of the target
+ *        could be replaced without a runt pulse.
+ * 
+ * A square blink has a boundary at every edge, a wave or a ramp at every
+ * frame, a pattern at every op and a timeline at once. The cycle end is 
+ * the start of the next cycle, and a blink offloaded to the hardware is 
+ * only cut there, as the engine does not see its edges.
+ *  
+ * @param[in]  self           : Pointer to the target of driver.
+ * @param[in]  now_us         : Current time base[us].
+ * @param[in]  at_cycle_end   : 1 to wait for the end of the cycle, else 0.
+ * @param[out] p_boundary_us  : Time base[us] of the boundary.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_boundary_get(
+                            const bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us,
+                            const uint32_t               at_cycle_end,
+                                  uint32_t           *const p_boundary_us
+                                    )
+{
+    led_status_t             ret       = LED_OK;
+    const led_blink_state_t *p_state   = NULL;
+    uint32_t                 cycle_ref = 0;
+
+    if ( NULL == self || LED_NOT_INITED == self->is_inited ||
+         NULL == p_boundary_us
+       )
+    {
+        DEBUG_OUT("Error: led_driver_boundary_get Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+    p_state        =                  &(self->blink_state);
+    *p_boundary_us =                 p_state->next_edge_us;
+
+    switch (p_state->phase)
+    {
+        case LED_PHASE_ON:
+        case LED_PHASE_OFF:
+            if ( 0 != at_cycle_end )
+            {
+                *p_boundary_us = __led_cycle_start_us(self) + 
+                                                  self->cycle_time_us;
+            }
+            break;
+        case LED_PHASE_WAVE:
+            if ( 0 != at_cycle_end )
+            {
+                *p_boundary_us = p_state->wave_start_us + 
+                                                  self->cycle_time_us;
+            }
+            break;
+        case LED_PHASE_TIMELINE:
+            // a fade has no edge to keep, it is cut at once.
+            if ( 0 == at_cycle_end )
+            {
+                *p_boundary_us = now_us;
+            }
+            break;
+        case LED_PHASE_HW:
+            // 1. the deadline is a cycle start, or the end of the on time
+            //    of the last cycle, less than LED_TIME_SPAN_MAX_US ahead.
+            cycle_ref = p_state->next_edge_us;
+            if ( 0 == p_state->blink_remaining )
+            {
+                cycle_ref -= p_state->on_time_us;
+            }
+            // 2. go back from it by whole cycles, or on from it when the
+            //    tick is late, one division per request.
+            if ( LED_TIME_BEFORE(cycle_ref, now_us) )
+            {
+                *p_boundary_us = cycle_ref + ((now_us - cycle_ref) /
+                          self->cycle_time_us + 1U) * self->cycle_time_us;
+            }
+            else
+            {
+                *p_boundary_us = cycle_ref - ((cycle_ref - now_us) /
+                                  self->cycle_time_us) * self->cycle_time_us;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief stop the blink engine of the target and leave the led off.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] end_us      : Time base[us] kept as the end of the command, 
+ *                          the epoch of the command played next.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_blink_cancel(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     end_us
+                                    )
+{
+    if ( NULL == self || LED_NOT_INITED == self->is_inited )
+    {
+        DEBUG_OUT("Error: The driver has not been initialized!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    // a timeline keeps its position, it may be resumed from there.
+    if ( LED_PHASE_TIMELINE == self->blink_state.phase )
+    {
+        led_timeline_position_keep(self, end_us);
+    }
+
+    self->blink_state.phase        = LED_PHASE_IDLE;
+    self->blink_state.next_edge_us =         end_us;
+
+    // a blink offloaded to the hardware is stopped by its duty.
+    return led_driver_level_write(self, 0);
+}
+
+/**
+ * @brief set the perceptual brightness of the target.
+ * 
+ * Steps:
+ * 1. check the target is idle and has a duty-cycle backend.
+ * 2. map the level through the CIE1931 table and write the duty.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] level       : Brightness level, 0 is off and 
+ *                          LED_GAMMA_LEVEL_MAX is full on.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_brightness_set(
+                                  bsp_led_driver_t   *const      self,
+                            const uint8_t                       level
+                                      )
+{
+    led_status_t ret = LED_OK;
+
+    /******************1.check target status******************/
+    if ( NULL == self || LED_NOT_INITED == self->is_inited )
+    {
+        DEBUG_OUT("Error: The driver has not been initialized!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    // 1-1. the blink engine owns the output until it becomes idle.
+    if ( LED_PHASE_IDLE != self->blink_state.phase )
+    {
+        DEBUG_OUT("Error: The led is blinking!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    // 1-2. only a duty-cycle backend could dim the led.
+    if ( NULL == self->p_led_opes->pf_led_set_duty )
+    {
+        DEBUG_OUT("Error: The led has no duty-cycle backend!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    /***********2.map the level to duty and write it**********/
+    // 2-1. a blink offloaded before may have left a long period.
+    ret = led_driver_dim_period_set(self);
+    if (LED_OK != ret)
+    {
+        return ret;
+    }
+    ret = led_driver_level_write(self, led_gamma_cie1931[level]);
+
+    return ret;
+}
+
+/**
+ * @brief write a duty to the led of the target and keep it as its output.
+ * 
+ * Without a duty-cycle backend the led could only be on or off, so any
+ * duty above 0 turns it on.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] duty        : Duty to be shown.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_level_write(
+                                  bsp_led_driver_t   *const      self,
+                            const led_duty_t                     duty
+                                   )
+{
+    if ( NULL == self->p_led_opes->pf_led_set_duty )
+    {
+        self->blink_state.output_duty = (0 < duty) ? LED_DUTY_FULL : 0;
+        return (0 < duty) ? self->p_led_opes->pf_led_on() :
+                            self->p_led_opes->pf_led_off();
+    }
+
+    self->blink_state.output_duty = duty;
+    return self->p_led_opes->pf_led_set_duty(duty);
+}
+
+/**
+ * @brief set the flicker free period of LED_DIM_PERIOD_US on the backend
+ *        of the target before it dims, a blink offloaded before may have
+ *        left a long period. A backend without period is left as it is.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_driver_dim_period_set(bsp_led_driver_t *const self)
+{
+    if ( NULL == self->p_led_opes->pf_led_set_duty   ||
+         NULL == self->p_led_opes->pf_led_set_period
+       )
+    {
+        return LED_OK;
+    }
+
+    return self->p_led_opes->pf_led_set_period(LED_DIM_PERIOD_US);
+}
+
+/**
+ * @brief check the requirement values of a blink request.
+ *  
+ * @param[in] cycle_time_ms    : The whole time of blink.
+ * @param[in] blink_times      : The times of blink.
+ * @param[in] duty             : The duty of led on, Q16 of LED_DUTY_FULL.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+static led_status_t __led_param_check (
+                        const uint32_t                cycle_time_ms    , 
+                        const uint32_t                blink_times      , 
+                        const led_duty_t                           duty 
+                                      )
+{
+    led_status_t ret = LED_OK;
+
+    if (
+        (cycle_time_ms     <=  0                   ) ||
+        (cycle_time_ms     >= 10000                ) ||
+        (blink_times       <=  0                   ) ||
+        (blink_times       >= 1000                 ) ||
+        (duty              >  LED_DUTY_FULL        )
+       )
+    {
+        DEBUG_OUT("Error: Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+    }
+
     return ret;
 }
-#endif // End of OS_SUPPORTING
 
 #ifndef OS_SUPPORTING
+/**
+ * @brief store the levels requested from a write-coalescing backend.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+static led_status_t __led_flush(bsp_led_driver_t *const self)
+{
+    if ( NULL == self->p_led_opes->pf_led_flush )
+    {
+        return LED_OK;
+    }
+
+    return self->p_led_opes->pf_led_flush();
+}
+
+/**
+ * @brief get the time base of the blink engine.
+ *  
+ * @param[in] self        : Pointer to the target of driver.
+ * 
+ * @return uint32_t : Time base[us], from the ms time base if no us one.
+ * 
+ * */
+static uint32_t __led_time_now_us(bsp_led_driver_t *const self)
+{
+    uint32_t now = 0;
+
+    if ( NULL != self->p_time_base->pf_get_time_base_us )
+    {
+        self->p_time_base->pf_get_time_base_us(&now);
+        return now;
+    }
+
+    // the product wraps like the us time base, the deadlines stay right.
+    self->p_time_base->pf_get_time_base_ms(&now);
+    return now * LED_US_PER_MS;
+}
+
 /**
  * @brief Link led_control to the enternal APIs of target.
  * 
@@ -126,7 +840,7 @@ static led_status_t led_blink(bsp_led_driver_t *const self)
  * @param[in] self             : Pointer to the target of handler.
  * @param[in] cycle_time_ms    : The whole time of blink.
  * @param[in] blink_times      : The times of blink.
- * @param[in] proportion_on_off: The proportion ralationship of led on and off.
+ * @param[in] duty             : The duty of led on, Q16 of LED_DUTY_FULL.
  * 
  * @return led_handler_status_t : Status of the function.
  * 
@@ -135,7 +849,7 @@ static led_status_t led_control (
                               bsp_led_driver_t *const self             , 
                         const uint32_t                cycle_time_ms    , 
                         const uint32_t                blink_times      , 
-                        const proportion_t            proportion_on_off 
+                        const led_duty_t                           duty 
                                 )
 {
     led_status_t ret = LED_OK;
@@ -155,27 +869,102 @@ static led_status_t led_control (
 
     /***************1.Check the input parameter***************/
     // 1-1. check if they are valid values.
-    if (
-        (cycle_time_ms     <=  0                   ) ||
-        (cycle_time_ms     >= 10000                ) ||
-        (blink_times       <=  0                   ) ||
-        (blink_times       >= 1000                 ) ||
-        (proportion_on_off <  PROPORTION_ON_OFF_1_1) ||
-        (proportion_on_off >= PROPORTION_ON_OFF_NUM)
-       )
+    ret = __led_param_check(cycle_time_ms, blink_times, duty);
+    if ( LED_OK != ret )
     {
         // 1-2. if the input parameter is invalid, return error.
-        DEBUG_OUT("Error: Parameter error!\r\n");
-        ret = LED_ERRORPARAMETER;
+        return ret;
     }
 
     /****************2.add the data in target****************/
-    self->cycle_time_ms     =     cycle_time_ms;
+    self->cycle_time_us     = cycle_time_ms * LED_US_PER_MS;
     self->blink_times       =       blink_times;
-    self->proportion_on_off = proportion_on_off; 
+    self->duty              =              duty; 
+    self->shape             =   LED_WAVE_SQUARE;
 
     /*************3. run the operation of target**************/
-    ret = led_blink(self);
+    ret = led_driver_blink_start(self, __led_time_now_us(self));
+
+    // 3-1. no OS to tick the engine, so poll the time base until idle.
+    //      the level requested by the last call is stored before the next.
+    while ( LED_OK == ret && LED_PHASE_IDLE != self->blink_state.phase )
+    {
+        __led_flush(self);
+        ret = led_driver_blink_tick(self, __led_time_now_us(self), NULL);
+    }
+    __led_flush(self);
+
+    return ret;
+}
+#else
+/**
+ * @brief Link led_control_async to the enternal APIs of target.
+ * 
+ * Steps:
+ * 1. check the status of target and the input parameter.
+ * 2. post the request to the handler which owns the target.
+ * 
+ * The call never waits for the blink, the handler's worker plays it and
+ * reports the end through p_completion in the worker's thread context.
+ *  
+ * @param[in] self             : Pointer to the target of driver.
+ * @param[in] cycle_time_ms    : The whole time of blink.
+ * @param[in] blink_times      : The times of blink.
+ * @param[in] duty             : The duty of led on, Q16 of LED_DUTY_FULL.
+ * @param[in] p_completion     : Callback and/or event flags notified when 
+ *                               the blink ends, NULL if not needed. 
+ *                               It is copied, so it may live on the stack.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+static led_status_t led_control_async (
+                              bsp_led_driver_t *const self             , 
+                        const uint32_t                cycle_time_ms    , 
+                        const uint32_t                blink_times      , 
+                        const led_duty_t                           duty,
+                        const led_completion_t *const p_completion
+                                      )
+{
+    led_status_t ret = LED_OK;
+    DEBUG_OUT("Info: Enter led_control_async!\r\n");
+    /******************0.check target status******************/
+    if ( 
+        NULL     == self                 ||
+        LED_NOT_INITED == self->is_inited  
+       )
+    {
+        DEBUG_OUT("Error: The driver has not been initialized!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    /***************1.Check the input parameter***************/
+    ret = __led_param_check(cycle_time_ms, blink_times, duty);
+    if ( LED_OK != ret )
+    {
+        return ret;
+    }
+
+    // 1-1. the blink engine is ticked by the handler only.
+    if ( NULL == self->pf_submit )
+    {
+        DEBUG_OUT("Error: The driver has not been registered!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    /***************2.Post the request to owner***************/
+    ret = self->pf_submit(self->p_owner    ,
+                          self             ,
+                          cycle_time_ms    ,
+                          blink_times      ,
+                          duty,
+                          p_completion     );
+    if ( LED_OK != ret )
+    {
+        DEBUG_OUT("Error: Post the blink request failed!\r\n");
+    }
 
     return ret;
 }
@@ -204,6 +993,11 @@ static led_status_t led_driver_init (bsp_led_driver_t *const self)
     }
 
     self->p_led_opes->pf_led_off();
+    // a write-coalescing backend only stores the off level on flush.
+    if ( NULL != self->p_led_opes->pf_led_flush )
+    {
+        self->p_led_opes->pf_led_flush();
+    }
     // self->p_led_opes_inst->pf_led_on();
     self->p_os_delay->pf_os_delay_ms(0x5a5a5a5a);
     uint32_t time_base = 0;
@@ -273,14 +1067,22 @@ led_status_t led_driver_inst (
     self->p_time_base = time_base;
 
     /*****4.Initialize the target of enternal requirement*****/
-    self->cycle_time_ms     =            0x5a5a5a5a;
+    self->cycle_time_us     =            0x5a5a5a5a;
     self->blink_times       =            0x5a5a5a5a;
-    self->proportion_on_off = PROPORTION_ON_OFF_x_x;
+    self->duty              =      LED_DUTY_INVALID;
+    self->shape             =       LED_WAVE_SQUARE;
+    self->blink_state.phase =        LED_PHASE_IDLE;
+    self->blink_state.output_duty =                0;
+    self->blink_state.p_timeline  =             NULL;
 
     /**************5.Link the enternal APIs*******************/
 #ifndef OS_SUPPORTING
-
     self->pf_led_controler = led_control;
+#else
+    // 5-1. the owner is mounted when the led is registered.
+    self->p_owner          =              NULL;
+    self->pf_submit        =              NULL;
+    self->pf_led_controler = led_control_async;
 #endif // End of OS_SUPPORTING
     ret = led_driver_init(self);
 
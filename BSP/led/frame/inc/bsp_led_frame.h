@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_frame.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's double buffered framebuffer of led output states.
+ *
+ * Processing flow:
+ *
+ * led_frame_init() -> led_frame_write() per led output
+ *                  -> led_frame_swap() once per engine tick
+ *                  -> led_frame_read() by any reader at any time.
+ *
+ * The producer composes the duties of a tick into the back frame and the
+ * swap publishes all of them at once by flipping the index of the front,
+ * so a reader never sees half of a multi-led update. There is one 
+ * producer per framebuffer, e.g. the worker which ticks its leds.
+ *
+ * A reader takes no lock. One slot is one word and is read as is, a whole
+ * frame is copied and copied again if a swap came in between, which is 
+ * once at most for a reader above the producer, e.g. an ISR.
+ *
+ * @version V1.0 2025-06-08
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_FRAME_H__
+#define __BSP_LED_FRAME_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Led outputs of one framebuffer                                           */
+#ifndef LED_FRAME_SLOT_NUM
+#define LED_FRAME_SLOT_NUM            (16U)
+#endif
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* Duty of every slot, the front and the back frame */
+    volatile led_duty_t          duty[2][LED_FRAME_SLOT_NUM];
+    /* Index of the published frame                    */
+    volatile uint32_t                                 front;
+    /* Swaps since the init, readers retry on a change */
+    volatile uint32_t                                   seq;
+    /* Non-zero if a slot changed since the swap       */
+    uint32_t                                          dirty;
+} led_frame_t;
+
+/**
+ * @brief init the framebuffer, every slot is off in both frames.
+ *
+ * @param[in] p_frame     : Pointer to the framebuffer.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_frame_init(led_frame_t *const p_frame);
+
+/**
+ * @brief compose the duty of a slot into the back frame, by the producer.
+ *
+ * @param[in] p_frame     : Pointer to the framebuffer.
+ * @param[in] slot        : Index of the led output.
+ * @param[in] duty        : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_frame_write(
+                                  led_frame_t        *const      p_frame,
+                            const uint32_t                          slot,
+                            const led_duty_t                        duty
+                            );
+
+/**
+ * @brief publish the back frame if a slot changed, by the producer.
+ *
+ * The new back frame starts as a copy of the front, so the slots not 
+ * written in the next tick keep their duty.
+ *
+ * @param[in] p_frame     : Pointer to the framebuffer.
+ *
+ * @return uint32_t : 1 if a frame is published, 0 if nothing changed.
+ *
+ * */
+uint32_t led_frame_swap(led_frame_t *const p_frame);
+
+/**
+ * @brief get the published duty of one slot.
+ *
+ * @param[in] p_frame     : Pointer to the framebuffer.
+ * @param[in] slot        : Index of the led output.
+ *
+ * @return led_duty_t : The duty, 0 if the slot is out of range.
+ *
+ * */
+led_duty_t led_frame_duty_get(
+                            const led_frame_t        *const      p_frame,
+                            const uint32_t                          slot
+                             );
+
+/**
+ * @brief copy the published frame, its slots all come from one swap.
+ *
+ * @param[in]  p_frame     : Pointer to the framebuffer.
+ * @param[out] p_duty      : The duties, LED_FRAME_SLOT_NUM entries.
+ *
+ * @return uint32_t : The sequence of the swap which published the copy.
+ *
+ * */
+uint32_t led_frame_read(
+                            const led_frame_t        *const      p_frame,
+                                  led_duty_t         *const       p_duty
+                       );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_FRAME_H__
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_frame.c
+ *
+ * @par dependencies
+ * - bsp_led_frame.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's double buffered framebuffer of led output states.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-06-08
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_frame.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+led_status_t led_frame_init(led_frame_t *const p_frame)
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_frame )
+    {
+        DEBUG_OUT("Error: led_frame_init Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    for (uint32_t slot = 0; slot < LED_FRAME_SLOT_NUM; slot++)
+    {
+        p_frame->duty[0][slot] = 0;
+        p_frame->duty[1][slot] = 0;
+    }
+    p_frame->front = 0;
+    p_frame->seq   = 0;
+    p_frame->dirty = 0;
+
+    return ret;
+}
+
+led_status_t led_frame_write(
+                                  led_frame_t        *const      p_frame,
+                            const uint32_t                          slot,
+                            const led_duty_t                        duty
+                            )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_frame || slot >= LED_FRAME_SLOT_NUM || 
+         duty >  LED_DUTY_FULL
+       )
+    {
+        DEBUG_OUT("Error: led_frame_write Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    p_frame->duty[p_frame->front ^ 1U][slot] = duty;
+    p_frame->dirty                           =    1;
+
+    return ret;
+}
+
+uint32_t led_frame_swap(led_frame_t *const p_frame)
+{
+    uint32_t front = 0;
+
+    if ( NULL == p_frame || 0 == p_frame->dirty )
+    {
+        return 0;
+    }
+
+    // 1. publish, then tell the readers of the old front to retry before
+    //    it is written again.
+    front          = p_frame->front ^ 1U;
+    p_frame->front = front;
+    p_frame->seq++;
+    p_frame->dirty = 0;
+
+    // 2. the next tick composes on top of what is shown.
+    for (uint32_t slot = 0; slot < LED_FRAME_SLOT_NUM; slot++)
+    {
+        p_frame->duty[front ^ 1U][slot] = p_frame->duty[front][slot];
+    }
+
+    return 1;
+}
+
+led_duty_t led_frame_duty_get(
+                            const led_frame_t        *const      p_frame,
+                            const uint32_t                          slot
+                             )
+{
+    if ( NULL == p_frame || slot >= LED_FRAME_SLOT_NUM )
+    {
+        return 0;
+    }
+
+    // one word, it is either the old or the new duty, never torn.
+    return p_frame->duty[p_frame->front][slot];
+}
+
+uint32_t led_frame_read(
+                            const led_frame_t        *const      p_frame,
+                                  led_duty_t         *const       p_duty
+                       )
+{
+    uint32_t seq   = 0;
+    uint32_t front = 0;
+
+    if ( NULL == p_frame || NULL == p_duty )
+    {
+        DEBUG_OUT("Error: led_frame_read Parameter error!\r\n");
+        return 0;
+    }
+
+    do
+    {
+        seq   =   p_frame->seq;
+        front = p_frame->front;
+        for (uint32_t slot = 0; slot < LED_FRAME_SLOT_NUM; slot++)
+        {
+            p_duty[slot] = p_frame->duty[front][slot];
+        }
+    } while ( seq != p_frame->seq );
+
+    return seq;
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_gamma.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's perceptual brightness table of the led.
+ *
+ * Processing flow:
+ *
+ * brightness level[0..255] -> led_gamma_cie1931[] -> duty[Q16].
+ *
+ * The table follows the CIE1931 lightness curve, it is folded by the
+ * compiler from constant expressions and lives in flash, so a lookup
+ * costs no math at run time.
+ *
+ * @version V1.0 2025-05-16
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_GAMMA_H__
+#define __BSP_LED_GAMMA_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Number of perceptual brightness levels                                   */
+#define LED_GAMMA_LEVEL_NUM           (256U)
+/* Max perceptual brightness level                                          */
+#define LED_GAMMA_LEVEL_MAX           (LED_GAMMA_LEVEL_NUM - 1U)
+
+/* Lightness L*[0..100] of the brightness level n                           */
+#define LED_GAMMA_L(n)           ((double)(n) * 100.0 / LED_GAMMA_LEVEL_MAX)
+/* Cube root of the luminance of L* above the linear part                   */
+#define LED_GAMMA_T(n)           ((LED_GAMMA_L(n) + 16.0) / 116.0)
+/* Relative luminance Y[0..1] of the level n, CIE1931                       */
+#define LED_GAMMA_Y(n)                                                        \
+    ((LED_GAMMA_L(n) <= 8.0) ? (LED_GAMMA_L(n) / 903.3)                   :  \
+     (LED_GAMMA_T(n) * LED_GAMMA_T(n) * LED_GAMMA_T(n)))
+/* Duty[Q16] of the level n, constant expression for constant n             */
+#define LED_GAMMA_CIE1931(n)                                                  \
+    ((led_duty_t)(LED_GAMMA_Y(n) * (double)LED_DUTY_FULL + 0.5))
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* Duty[Q16] of every perceptual brightness level, 0 is off and
+   LED_GAMMA_LEVEL_MAX is LED_DUTY_FULL                                     */
+extern const led_duty_t led_gamma_cie1931[LED_GAMMA_LEVEL_NUM];
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_GAMMA_H__
@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_gamma.c
+ *
+ * @par dependencies
+ * - bsp_led_gamma.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's perceptual brightness table of the led.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-05-16
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_gamma.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Expand the table entries of 4, 16, 64 and 256 levels from level n        */
+#define __GAMMA_4(n)                                                          \
+    LED_GAMMA_CIE1931((n) + 0), LED_GAMMA_CIE1931((n) + 1),                   \
+    LED_GAMMA_CIE1931((n) + 2), LED_GAMMA_CIE1931((n) + 3)
+#define __GAMMA_16(n)                                                         \
+    __GAMMA_4((n) +  0), __GAMMA_4((n) +  4),                                 \
+    __GAMMA_4((n) +  8), __GAMMA_4((n) + 12)
+#define __GAMMA_64(n)                                                         \
+    __GAMMA_16((n) +  0), __GAMMA_16((n) + 16),                               \
+    __GAMMA_16((n) + 32), __GAMMA_16((n) + 48)
+#define __GAMMA_256(n)                                                        \
+    __GAMMA_64((n) +   0), __GAMMA_64((n) +  64),                             \
+    __GAMMA_64((n) + 128), __GAMMA_64((n) + 192)
+
+/* Folded at compile time, const keeps it in flash                          */
+const led_duty_t led_gamma_cie1931[LED_GAMMA_LEVEL_NUM] =
+{
+    __GAMMA_256(0)
+};
+//******************************** Defines **********************************//
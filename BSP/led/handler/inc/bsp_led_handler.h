@@ -50,6 +50,29 @@
 
 /* Initialization pattern                */
 #define INIT_PATTERN  (bsp_led_driver_t*)(0xA6A6A6A6)
+
+/* Depth of the led command queue, it 
+   should absorb a burst of producers    */
+#define LED_HANDLER_QUEUE_DEPTH       (16U)
+/* Number of workers in the thread pool,
+   leds are dispatched to them by index  */
+#define LED_HANDLER_WORKER_NUM        (2U)
+/* Stack depth[word] of one worker       */
+#define LED_HANDLER_WORKER_STACK      (512U)
+/* Timeout[ms] of waiting without end,
+   same value as osWaitForever           */
+#define LED_HANDLER_WAIT_FOREVER      (0xFFFFFFFFU)
+/* Commands held per busy led            */
+#define LED_HANDLER_PENDING_DEPTH     (4U)
+/* Words of the bit masks, one bit per 
+   led of the handler                    */
+#define LED_HANDLER_MASK_WORDS        ((MAX_INSTANCE_NUBER + 31U) / 32U)
+/* Distinct backend flushes collected in
+   one tick, more are called at once     */
+#define LED_HANDLER_FLUSH_NUM         (8U)
+/* Groups of one handler, each group 
+   takes one index of led                */
+#define LED_HANDLER_GROUP_NUM         (2U)
                                     
 
 typedef enum
@@ -83,6 +106,7 @@ typedef enum
     HANDLER_ERRORPARAMETER =    4,  /* Parameter error.                      */
     HANDLER_ERRORNOMEMORY  =    5,  /* Out of memory.                        */
     HANDLER_ERRORISR       =    6,  /* Not allowed in ISR context            */
+    HANDLER_ERRORCANCELLED =    7,  /* Replaced by a newer command           */
     HANDLER_STATUS_NUM           ,  /* Number of handler status              */
     HANDLER_RESERVED       = 0xFF,  /* Reserved                              */
 } led_handler_status_t;
@@ -93,12 +117,43 @@ typedef enum
 
 typedef struct bsp_led_handler_s bsp_led_handler_t;
 
+typedef enum
+{
+    LED_EVENT_BLINK        =    0,  /* Blink sequence of the led.            */
+    LED_EVENT_BRIGHTNESS   =    1,  /* Perceptual brightness of the led.     */
+    LED_EVENT_PATTERN      =    2,  /* Bytecode pattern in flash.            */
+    LED_EVENT_TIMELINE     =    3,  /* Keyframe timeline in flash.           */
+} led_event_type_t;
+
+typedef enum
+{
+    LED_POLICY_QUEUE       =    0,  /* Play after the commands before.       */
+    LED_POLICY_NOW         =    1,  /* Replace them at the next edge.        */
+    LED_POLICY_CYCLE_END   =    2,  /* Replace them at the end of the cycle. */
+    LED_POLICY_NUM               ,  /* Number of policies                    */
+} led_event_policy_t;
+
 typedef struct
 {
     led_index_t                 index;
-    uint32_t            cycle_time_ms;
+    led_event_type_t             type;
+    uint32_t            cycle_time_us;
     uint32_t              blink_times;
-    proportion_t    proportion_on_off;
+    led_duty_t                   duty;
+    led_wave_shape_t            shape;
+    /* Level of LED_EVENT_BRIGHTNESS     */
+    uint8_t                brightness;
+    /* Pattern of LED_EVENT_PATTERN      */
+    const led_pattern_op_t *p_pattern;
+    /* Timeline of LED_EVENT_TIMELINE, 
+       NULL pauses the one being played  */
+    const led_timeline_t  *p_timeline;
+    /* Position[ms] to play it from      */
+    uint32_t              timeline_ms;
+    /* Notified when the blink ends      */
+    led_completion_t       completion;
+    /* What to do if the led is busy     */
+    led_event_policy_t         policy;
 } led_event_t;
 
 #ifdef OS_SUPPORTING
@@ -203,14 +258,132 @@ typedef struct
     uint32_t                                   led_instance_count;
 } instance_regiseted_t;
 
+typedef struct
+{
+    /* OS thread's Handler of the worker               */
+    void                               *p_thread_handler;
+    /* OS queue's Handler of the worker                */
+    void                                *p_queue_handler;
+    /* The handler which the worker belongs to         */
+    bsp_led_handler_t                         *p_handler;
+    /* Index of the worker in the pool                 */
+    uint32_t                                   worker_id;
+} handler_worker_t;
+
+typedef struct
+{
+    /* Workers of the pool                             */
+    handler_worker_t         workers[LED_HANDLER_WORKER_NUM];
+    /* Number of workers created                       */
+    uint32_t                                    worker_count;
+    /* Worker id which owns the led of the same index  */
+    uint8_t                      dispatch[MAX_INSTANCE_NUBER];
+    /* Commands of the led in the queue of its worker,
+       counted with dispatch in the critical section   */
+    uint8_t                        queued[MAX_INSTANCE_NUBER];
+} handler_thread_pool_t;
+
+typedef struct
+{
+    /* Commands waiting for the led to become idle     */
+    led_event_t             events[LED_HANDLER_PENDING_DEPTH];
+    /* Index of the oldest command                     */
+    uint32_t                                            head;
+    /* Number of commands held                         */
+    uint32_t                                           count;
+} led_pending_t;
+
+typedef struct
+{
+    /* Bit per led whose blink engine is not idle      */
+    uint32_t                 active[LED_HANDLER_MASK_WORDS];
+    /* Bit per led with commands held                  */
+    uint32_t                pending[LED_HANDLER_MASK_WORDS];
+    /* Bit per led written since the last flush        */
+    uint32_t                touched[LED_HANDLER_MASK_WORDS];
+    /* Bit per led whose group is playing              */
+    uint32_t                grouped[LED_HANDLER_MASK_WORDS];
+    /* Bit per led whose command is to be replaced     */
+    uint32_t              replacing[LED_HANDLER_MASK_WORDS];
+} handler_engine_mask_t;
+
+typedef struct
+{
+    /* Deadline[us] of the next edge, valid if active  */
+    uint32_t              next_edge_us[MAX_INSTANCE_NUBER];
+    /* Boundary[us] at which the command is replaced   */
+    uint32_t                replace_us[MAX_INSTANCE_NUBER];
+    /* Masks of every worker, written by it alone      */
+    handler_engine_mask_t     masks[LED_HANDLER_WORKER_NUM];
+} handler_engine_table_t;
+
+typedef struct
+{
+    /* Engine of the group, it drives no pin, its 
+       outputs are written to every member             */
+    bsp_led_driver_t                              leader;
+    /* Bit per led which follows the group             */
+    uint32_t                members[LED_HANDLER_MASK_WORDS];
+    /* Duty last written to the members                */
+    led_duty_t                                    output;
+} handler_group_t;
+
 typedef led_handler_status_t (*pf_handler_led_control_t) (
                              bsp_led_handler_t *const             self,
                        const led_index_t                     led_index,
                        const uint32_t                    cycle_time_ms,
                        const uint32_t                      blink_times,
-                       const proportion_t            proportion_on_off
+                       const led_duty_t                           duty
                                                          );
 
+typedef led_handler_status_t (*pf_handler_led_control_us_t) (
+                             bsp_led_handler_t *const             self,
+                       const led_index_t                     led_index,
+                       const uint32_t                    cycle_time_us,
+                       const uint32_t                      blink_times,
+                       const led_duty_t                           duty
+                                                            );
+
+typedef led_handler_status_t (*pf_handler_led_wave_t) (
+                             bsp_led_handler_t *const             self,
+                       const led_index_t                     led_index,
+                       const led_wave_shape_t                    shape,
+                       const uint32_t                    cycle_time_ms,
+                       const uint32_t                      blink_times,
+                       const led_duty_t                           peak
+                                                      );
+
+typedef led_handler_status_t (*pf_handler_led_brightness_t) (
+                             bsp_led_handler_t *const             self,
+                       const led_index_t                     led_index,
+                       const uint8_t                             level
+                                                            );
+
+typedef led_handler_status_t (*pf_handler_led_pattern_t) (
+                             bsp_led_handler_t *const             self,
+                       const led_index_t                     led_index,
+                       const led_pattern_op_t *const         p_pattern
+                                                         );
+
+typedef led_handler_status_t (*pf_handler_led_timeline_t) (
+                             bsp_led_handler_t *const             self,
+                       const led_index_t                     led_index,
+                       const led_timeline_t    *const       p_timeline,
+                       const uint32_t                           pos_ms
+                                                          );
+
+typedef led_handler_status_t (*pf_handler_led_request_t) (
+                             bsp_led_handler_t *const             self,
+                       const led_event_t       *const        p_request
+                                                         );
+
+typedef led_handler_status_t (*pf_handler_group_create_t) (
+                             bsp_led_handler_t *const             self,
+                       const led_index_t       *const        p_members,
+                       const uint32_t                       member_num,
+                             led_index_t       *const    p_group_index
+                                                          );
+
 typedef led_handler_status_t (*pf_led_register_t) (
                             bsp_led_handler_t *const      self,
                             bsp_led_driver_t  *const       led,
@@ -224,10 +397,20 @@ typedef struct bsp_led_handler_s
     led_handler_init_t                         is_inited;
     /* Regiseted instances                             */
     instance_regiseted_t                       instances;
-    /* OS queue's Handler                              */
-    void                             *p_os_queue_handler;
-    /* OS thread's Handler                             */
-    void                            *p_os_thread_handler;
+    /* Commands held back while the led is blinking    */
+    led_pending_t              pending[MAX_INSTANCE_NUBER];
+    /* OS thread pool and the led dispatch table       */
+    handler_thread_pool_t                    thread_pool;
+    /* Completion of the command being played per led  */
+    led_completion_t           running[MAX_INSTANCE_NUBER];
+    /* Dense state of the engines scanned per tick     */
+    handler_engine_table_t                        engine;
+    /* Groups of leds which share one schedule         */
+    handler_group_t             groups[LED_HANDLER_GROUP_NUM];
+    /* Number of groups created                        */
+    uint32_t                                 group_count;
+    /* Bit per led index which is a group              */
+    uint32_t             group_mask[LED_HANDLER_MASK_WORDS];
 
     /*****************Internal interfaces of the handler*********************/
 #ifdef OS_SUPPORTING
@@ -243,6 +426,13 @@ typedef struct bsp_led_handler_s
     /*****************External interfaces of the handler*********************/
     /* The API for AP                                  */
     pf_handler_led_control_t    pf_handler_led_controler;
+    pf_handler_led_control_us_t pf_handler_led_control_us;
+    pf_handler_led_brightness_t pf_handler_led_brightness;
+    pf_handler_led_wave_t             pf_handler_led_wave;
+    pf_handler_led_pattern_t       pf_handler_led_pattern;
+    pf_handler_led_timeline_t     pf_handler_led_timeline;
+    pf_handler_led_request_t       pf_handler_led_request;
+    pf_handler_group_create_t     pf_handler_group_create;
     /* The API for internal led driver                 */
     pf_led_register_t                    pf_led_register;
 
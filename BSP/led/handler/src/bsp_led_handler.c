@@ -7,6 +7,8 @@
  *
  * @par dependencies
  * - bsp_led_handler.h
+ * - bsp_led_pattern.h
+ * - bsp_led_timeline.h
  *
  * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
  *
@@ -25,11 +27,18 @@
 
 //******************************** Includes *********************************//
 #include "bsp_led_handler.h"
+#include "bsp_led_pattern.h"
+#include "bsp_led_timeline.h"
 #include "cmsis_os2.h"
 //******************************** Includes *********************************//
 
 
 //******************************** Defines **********************************//
+
+/* Word and bit of a led in the masks of the engine table                   */
+#define __MASK_WORD(led_number)       ((uint32_t)(led_number) >> 5)
+#define __MASK_BIT(led_number)        (1UL << ((uint32_t)(led_number) & 31U))
+
 /**
  * @brief helper function to initialize led_instance array of handler.
  * 
@@ -55,77 +64,545 @@ static led_handler_status_t __array_init(
     return ret;
 }
 
-static led_handler_status_t led_blink(bsp_led_driver_t *const self) 
+/**
+ * @brief notify the owner of a command that its blink has ended.
+ * 
+ * It runs in the worker's thread context, so pf_done must not block.
+ * 
+ * @param[in] p_led_instance : the led which played the command.
+ * @param[in] p_completion   : the completion of the command.
+ * @param[in] status         : result of the command.
+ * 
+ * */
+static void __event_complete(
+                            bsp_led_driver_t  *const p_led_instance,
+                      const led_completion_t  *const   p_completion,
+                      const led_status_t                     status
+                            )
 {
-    led_handler_status_t ret = HANDLER_OK;
-    DEBUG_OUT("Info: Enter led_blink!\r\n");
+    if ( NULL != p_completion->pf_done )
+    {
+        p_completion->pf_done(p_led_instance, status, p_completion->p_arg);
+    }
 
-    // 1. check if the target has been initialized.
-    if (
-        NULL     == self                  ||
-        LED_NOT_INITED == self->is_inited
+    if ( NULL != p_completion->p_event_flags )
+    {
+        osEventFlagsSet((osEventFlagsId_t)p_completion->p_event_flags,
+                                          p_completion->flags        );
+    }
+}
+
+/**
+ * @brief get the time base of the blink engines.
+ * 
+ * @param[in] self           : Pointer to the target of handler.
+ * 
+ * @return uint32_t : Time base[us], from the ms time base if no us one.
+ * 
+ * */
+static uint32_t __time_now_us(bsp_led_handler_t *const self)
+{
+    uint32_t now = 0;
+
+    if ( NULL != self->p_time_base->pf_get_time_base_us )
+    {
+        self->p_time_base->pf_get_time_base_us(&now);
+        return now;
+    }
+
+    // the product wraps like the us time base, the deadlines stay right.
+    self->p_time_base->pf_get_time_base_ms(&now);
+    return now * LED_US_PER_MS;
+}
+
+static led_status_t __group_output_none(void)
+{
+    return LED_OK;
+}
+
+static led_status_t __group_duty_none(const uint32_t duty)
+{
+    (void)duty;
+    return LED_OK;
+}
+
+/* The leader of a group drives no pin, its output is read back from
+   output_duty, and without pf_led_set_period it is never offloaded.        */
+static const led_operations_t __group_ops =
+{
+    .pf_led_on       = __group_output_none,
+    .pf_led_off      = __group_output_none,
+    .pf_led_set_duty =   __group_duty_none,
+};
+
+/**
+ * @brief write the output of the leader of a group to its members, the
+ *        members are marked touched, so each backend is flushed once.
+ * 
+ * @param[in] self           : Pointer to the target of handler.
+ * @param[in] p_group        : the group whose leader has been advanced.
+ * 
+ * */
+static void __group_apply(
+                            bsp_led_handler_t *const           self,
+                            handler_group_t   *const        p_group
+                         )
+{
+    const led_duty_t         duty    = 
+                                p_group->leader.blink_state.output_duty;
+    handler_engine_mask_t   *p_masks = NULL;
+    uint32_t                 bits    = 0;
+    uint32_t                 member  = 0;
+
+    if ( duty == p_group->output )
+    {
+        return;
+    }
+    p_group->output = duty;
+
+    for ( uint32_t word = 0; word < LED_HANDLER_MASK_WORDS; ++ word )
+    {
+        bits = p_group->members[word];
+        for ( uint32_t bit = 0; 0 != bits; ++ bit, bits >>= 1 )
+        {
+            if ( 0 == (bits & 1U) )
+            {
+                continue;
+            }
+            member  = (word << 5) + bit;
+            p_masks = &(self->engine.masks[
+                                    self->thread_pool.dispatch[member]]);
+            led_driver_level_write(
+                          self->instances.p_led_instance_group[member], duty);
+            p_masks->touched[word] |= __MASK_BIT(member);
+        }
+    }
+}
+
+/**
+ * @brief copy the state of the engine of a led into the dense table, after
+ *        it has been started or ticked.
+ * 
+ * @param[in] self           : Pointer to the target of handler.
+ * @param[in] led_number     : the index of the led.
+ * 
+ * */
+static void __engine_sync(
+                            bsp_led_handler_t *const           self,
+                      const uint32_t                     led_number
+                         )
+{
+    const led_blink_state_t *p_state = 
+              &(self->instances.p_led_instance_group[led_number]->blink_state);
+    handler_engine_mask_t   *p_masks = 
+              &(self->engine.masks[self->thread_pool.dispatch[led_number]]);
+
+    // an idle engine keeps the end of its command, the epoch of the next.
+    self->engine.next_edge_us[led_number]         =   p_state->next_edge_us;
+    if ( LED_PHASE_IDLE == p_state->phase )
+    {
+        p_masks->active[__MASK_WORD(led_number)]    &= 
+                                                    ~__MASK_BIT(led_number);
+        p_masks->replacing[__MASK_WORD(led_number)] &= 
+                                                    ~__MASK_BIT(led_number);
+    }
+    else
+    {
+        p_masks->active[__MASK_WORD(led_number)] |=  __MASK_BIT(led_number);
+    }
+
+    // a command to be replaced wakes the worker at its boundary too.
+    if ( 0 != (p_masks->replacing[__MASK_WORD(led_number)] &
+                                                __MASK_BIT(led_number))  &&
+         LED_TIME_BEFORE(self->engine.replace_us[led_number],
+                         p_state->next_edge_us)
        )
     {
-        DEBUG_OUT("Error: The driver has not been initialized!\r\n");
+        self->engine.next_edge_us[led_number] = 
+                                    self->engine.replace_us[led_number];
+    }
+    p_masks->touched[__MASK_WORD(led_number)]    |=  __MASK_BIT(led_number);
+
+    if ( 0 == (self->group_mask[__MASK_WORD(led_number)] &
+                                                __MASK_BIT(led_number)) )
+    {
+        return;
+    }
+
+    // a group holds the own commands of its members while it plays.
+    for ( uint32_t group = 0; group < self->group_count; ++ group )
+    {
+        if ( self->instances.p_led_instance_group[led_number] !=
+                                          &(self->groups[group].leader) )
+        {
+            continue;
+        }
+        for ( uint32_t word = 0; word < LED_HANDLER_MASK_WORDS; ++ word )
+        {
+            p_masks->grouped[word] = 
+                (LED_PHASE_IDLE == p_state->phase) ?
+                (p_masks->grouped[word] & ~self->groups[group].members[word]):
+                (p_masks->grouped[word] |  self->groups[group].members[word]);
+        }
+        __group_apply(self, &(self->groups[group]));
+        // the members are free again, the next start writes them anyway.
+        if ( LED_PHASE_IDLE == p_state->phase )
+        {
+            self->groups[group].output = LED_DUTY_INVALID;
+        }
+    }
+}
+
+/**
+ * @brief load the event into the led instance and arm its blink engine.
+ * 
+ * @param[in] self           : Pointer to the target of handler.
+ * @param[in] led_number     : the index of led which the event is sent to.
+ * @param[in] p_msg          : the event.
+ * @param[in] now_us         : current time base[us], or the end of the
+ *                             command before if the event was pending.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t __event_start(
+                            bsp_led_handler_t *const           self,
+                      const uint32_t                     led_number,
+                      const led_event_t       *const          p_msg,
+                      const uint32_t                         now_us
+                                         )
+{
+    led_handler_status_t ret            = HANDLER_OK;
+    led_status_t         status         = LED_OK;
+    bsp_led_driver_t    *p_led_instance = 
+                         self->instances.p_led_instance_group[led_number];
+
+    switch (p_msg->type)
+    {
+        case LED_EVENT_BLINK:
+            DEBUG_OUT("Info: Cycle time = %dus, Blink times = %d, "
+                      "Duty = 0x%x\r\n",
+                      p_msg->cycle_time_us,
+                      p_msg->blink_times,
+                      p_msg->duty);
+            p_led_instance->cycle_time_us =     p_msg->cycle_time_us;
+            p_led_instance->blink_times   =       p_msg->blink_times;
+            p_led_instance->duty          =              p_msg->duty;
+            p_led_instance->shape         =             p_msg->shape;
+            status = led_driver_blink_start(p_led_instance, now_us);
+            break;
+        case LED_EVENT_BRIGHTNESS:
+            DEBUG_OUT("Info: Brightness = %d\r\n", p_msg->brightness);
+            status = led_driver_brightness_set(p_led_instance,
+                                               p_msg->brightness);
+            break;
+        case LED_EVENT_PATTERN:
+            DEBUG_OUT("Info: Pattern = %p\r\n",
+                      (const void *)p_msg->p_pattern);
+            status = led_pattern_start(p_led_instance,
+                                       p_msg->p_pattern, now_us);
+            break;
+        case LED_EVENT_TIMELINE:
+            DEBUG_OUT("Info: Timeline = %p at %dms\r\n",
+                      (const void *)p_msg->p_timeline, p_msg->timeline_ms);
+            status = (NULL == p_msg->p_timeline) ?
+                     led_timeline_pause(p_led_instance) :
+                     led_timeline_start(p_led_instance, p_msg->p_timeline,
+                                        p_msg->timeline_ms, now_us);
+            break;
+        default:
+            status = LED_ERRORPARAMETER;
+            break;
+    }
+    __engine_sync(self, led_number);
+
+    if ( LED_OK != status )
+    {
+        DEBUG_OUT("Error: The led event start failed!\r\n");
         ret = HANDLER_ERRORRESOURCE;
+        __event_complete(p_led_instance, &(p_msg->completion), status);
         return ret;
     }
 
+    // an event without duration, e.g. brightness, is over already.
+    if ( LED_PHASE_IDLE == p_led_instance->blink_state.phase )
     {
-        // 2. analyze the target's parameters.
-        // 2-1. save target's parameters to local variables.
-        uint32_t     cycle_time_local        =     self->cycle_time_ms;
-        uint32_t     blink_times_total       =       self->blink_times;
-        proportion_t proportion_on_off_local = self->proportion_on_off;
-        
-        // 2-2. calculate the proportion time of led on and off.
-        uint32_t     led_toggle_time         =              0x5a5a5a5a;
-        switch (proportion_on_off_local)
+        __event_complete(p_led_instance, &(p_msg->completion), LED_OK);
+        return ret;
+    }
+
+    // keep the completion until the engine becomes idle.
+    self->running[led_number] = p_msg->completion;
+
+    return ret;
+}
+
+/**
+ * @brief advance the blink engine of every registered led.
+ * 
+ * Steps:
+ * 1. find the expired leds by one linear pass over the dense deadlines.
+ * 2. tick the expired leds, only they are reached through their pointer,
+ *    or stop them at the boundary where a newer command replaces them.
+ * 3. start the oldest pending event of the leds which become idle, at the
+ *    end of the command before, so a chain of commands does not drift.
+ * 4. find out how long the thread could sleep until the next deadline.
+ * 5. store the outputs of write-coalescing backends once per tick.
+ *  
+ * @param[in]  self            : Pointer to the target of handler.
+ * @param[in]  worker_id       : Only the leds owned by the worker are ticked.
+ * @param[out] p_timeout_ms    : Time[ms] until the earliest deadline, 
+ *                               rounded up to the OS tick, or
+ *                               LED_HANDLER_WAIT_FOREVER if all are idle.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t __engine_tick(
+                            bsp_led_handler_t *const         self,
+                      const uint32_t                    worker_id,
+                            uint32_t          *const p_timeout_ms
+                                         )
+{
+    led_handler_status_t   ret            = HANDLER_OK;
+    handler_engine_mask_t *p_masks        = &(self->engine.masks[worker_id]);
+    const uint32_t        *p_next_edge_us = self->engine.next_edge_us;
+    bsp_led_driver_t      *p_led_instance = NULL;
+    led_pending_t         *p_pending      = NULL;
+    uint32_t               now_us         = 0;
+    uint32_t               timeout_ms     = LED_HANDLER_WAIT_FOREVER;
+    int32_t                remaining_us   = 0;
+    uint32_t               expired        = 0;
+    uint32_t               ended          = 0;
+    uint32_t               bits           = 0;
+    uint32_t               led_number     = 0;
+    led_status_t           status         = LED_OK;
+    uint32_t               flush_num      = 0;
+    uint32_t               flush          = 0;
+    led_status_t         (*pf_flush)(void) = NULL;
+    led_status_t         (*flushes[LED_HANDLER_FLUSH_NUM])(void);
+
+    now_us = __time_now_us(self);
+
+    for ( uint32_t word = 0; word < LED_HANDLER_MASK_WORDS; ++ word )
+    {
+        // 1. compare every deadline of the word without a branch, the
+        //    idle leds are masked out afterwards.
+        expired = 0;
+        for ( uint32_t bit = 0;
+              bit < 32U && (word << 5) + bit < MAX_INSTANCE_NUBER;
+              ++ bit
+            )
         {
-            case PROPORTION_ON_OFF_1_1:
-                led_toggle_time = cycle_time_local / 2;
-                break;
-            case PROPORTION_ON_OFF_1_2:
-                led_toggle_time = cycle_time_local / 3;
-                break;
-            case PROPORTION_ON_OFF_1_3:
-                led_toggle_time = cycle_time_local / 4;
-                break;
-            default:
-                DEBUG_OUT("\
-                    calculate the proportion time of led on and off failed!\r\n");
-                ret = HANDLER_ERRORPARAMETER;
-                return ret;
+            expired |= (uint32_t)!LED_TIME_BEFORE(now_us,
+                                    p_next_edge_us[(word << 5) + bit]) << bit;
         }
+        expired &= p_masks->active[word];
+        ended    =                       0;
 
-        // 3. run the operation of led.
-        for (
-             uint32_t blink_number = 0; 
-             blink_number < blink_times_total; 
-             ++ blink_number
-            ) 
+        // 2. only the leds whose deadline has expired are advanced.
+        for ( uint32_t bit = 0; 0 != expired; ++ bit, expired >>= 1 )
         {
-            for (
-                uint32_t start_cycyle_time = 0;
-                start_cycyle_time < cycle_time_local;
-                ++ start_cycyle_time
-                )
+            if ( 0 == (expired & 1U) )
             {
-                if (start_cycyle_time >= led_toggle_time)
-                {
-                    self->p_led_opes->pf_led_off();
-                }
-                else
+                continue;
+            }
+            led_number     = (word << 5) + bit;
+            p_led_instance = self->instances.p_led_instance_group[led_number];
+            status         = LED_OK;
+            if ( 0 != (p_masks->replacing[word] & (1UL << bit))       &&
+                 !LED_TIME_BEFORE(now_us, 
+                                  self->engine.replace_us[led_number])
+               )
+            {
+                // 2-1. the boundary is the epoch of the newer command.
+                led_driver_blink_cancel(p_led_instance, 
+                                    self->engine.replace_us[led_number]);
+                status = LED_ERRORCANCELLED;
+            }
+            else
+            {
+                led_driver_blink_tick(p_led_instance, now_us, NULL);
+            }
+            __engine_sync(self, led_number);
+
+            // 2-2. the blink is over, tell the owner of the command.
+            if ( LED_PHASE_IDLE == p_led_instance->blink_state.phase )
+            {
+                __event_complete(p_led_instance, 
+                                 &(self->running[led_number]),
+                                 status                      );
+                memset(&(self->running[led_number]), 0,
+                       sizeof(self->running[led_number]));
+                ended |= 1UL << bit;
+            }
+        }
+
+        // 3. the led is free, start the oldest pending event.
+        bits = p_masks->pending[word] & ~p_masks->active[word] &
+                                        ~p_masks->grouped[word];
+        for ( uint32_t bit = 0; 0 != bits; ++ bit, bits >>= 1 )
+        {
+            if ( 0 == (bits & 1U) )
+            {
+                continue;
+            }
+            led_number = (word << 5) + bit;
+            p_pending  = &(self->pending[led_number]);
+            ret = __event_start(self,
+                                led_number,
+                                &(p_pending->events[p_pending->head]),
+                                (0 != (ended & (1UL << bit))) ?
+                                p_next_edge_us[led_number] : now_us);
+            p_pending->head = (p_pending->head + 1) % 
+                                            LED_HANDLER_PENDING_DEPTH;
+            p_pending->count--;
+            if ( 0 == p_pending->count )
+            {
+                p_masks->pending[word] &= ~(1UL << bit);
+            }
+        }
+
+        // 4. keep the earliest deadline of the leds still blinking.
+        bits = p_masks->active[word];
+        for ( uint32_t bit = 0; 0 != bits; ++ bit, bits >>= 1 )
+        {
+            if ( 0 == (bits & 1U) )
+            {
+                continue;
+            }
+            remaining_us = (int32_t)(p_next_edge_us[(word << 5) + bit] - 
+                                                                   now_us);
+            // 4-1. a deadline within the tick wakes the thread one tick
+            //      later, the edge is served late rather than early.
+            if ( remaining_us <= 0 )
+            {
+                timeout_ms = 0;
+            }
+            else if ( ((uint32_t)remaining_us + LED_US_PER_MS - 1) / 
+                                            LED_US_PER_MS < timeout_ms )
+            {
+                timeout_ms = ((uint32_t)remaining_us + LED_US_PER_MS - 1) /
+                                                            LED_US_PER_MS;
+            }
+        }
+    }
+
+    // 4-2. a led released by its group in an earlier word starts its
+    //      pending event in the next pass.
+    for ( uint32_t word = 0; word < LED_HANDLER_MASK_WORDS; ++ word )
+    {
+        if ( 0 != (p_masks->pending[word] & ~p_masks->active[word] &
+                                             ~p_masks->grouped[word]) )
+        {
+            timeout_ms = 0;
+        }
+    }
+
+    // 5. the leds of one backend share its flush, e.g. one GPIO port
+    //    shadow, so each distinct flush is collected once and called at
+    //    last, even if the leds of the backends interleave.
+    //    Only the leds written since the last tick are visited.
+    for ( uint32_t word = 0; word < LED_HANDLER_MASK_WORDS; ++ word )
+    {
+        bits                   = p_masks->touched[word];
+        p_masks->touched[word] =                       0;
+        for ( uint32_t bit = 0; 0 != bits; ++ bit, bits >>= 1 )
+        {
+            if ( 0 == (bits & 1U) )
+            {
+                continue;
+            }
+            p_led_instance = 
+                self->instances.p_led_instance_group[(word << 5) + bit];
+            pf_flush       = p_led_instance->p_led_opes->pf_led_flush;
+            if ( NULL == pf_flush )
+            {
+                continue;
+            }
+            for ( flush = 0; flush < flush_num; ++ flush )
+            {
+                if ( pf_flush == flushes[flush] )
                 {
-                    self->p_led_opes->pf_led_on();
+                    break;
                 }
             }
+            if ( flush < flush_num )
+            {
+                continue;
+            }
+            // 5-1. the table is full, the backend is flushed right away.
+            if ( LED_HANDLER_FLUSH_NUM == flush_num )
+            {
+                pf_flush();
+                continue;
+            }
+            flushes[flush_num++] = pf_flush;
         }
     }
 
+    for ( flush = 0; flush < flush_num; ++ flush )
+    {
+        flushes[flush]();
+    }
+
+    *p_timeout_ms = timeout_ms;
+
     return ret;
 }
 
+/**
+ * @brief let a newer command supersede the commands of a busy led.
+ * 
+ * Steps:
+ * 1. cancel the commands held for the led, the newer one is held alone.
+ * 2. stop the running command at its next boundary, see 
+ *    led_driver_boundary_get(), the newer one starts right there.
+ * 
+ * @param[in] self           : Pointer to the target of handler.
+ * @param[in] p_msg          : the newer command, its index is valid.
+ * 
+ * */
+static void __event_replace(
+                            bsp_led_handler_t *const           self,
+                      const led_event_t       *const          p_msg
+                           )
+{
+    bsp_led_driver_t      *p_led_instance = 
+                          self->instances.p_led_instance_group[p_msg->index];
+    led_pending_t         *p_pending      = &(self->pending[p_msg->index]);
+    handler_engine_mask_t *p_masks        = 
+                  &(self->engine.masks[self->thread_pool.dispatch[
+                                                            p_msg->index]]);
+
+    // 1. the owners of the commands held are told they are superseded.
+    while ( 0 != p_pending->count )
+    {
+        __event_complete(p_led_instance,
+                         &(p_pending->events[p_pending->head].completion),
+                         LED_ERRORCANCELLED                              );
+        p_pending->head = (p_pending->head + 1) % LED_HANDLER_PENDING_DEPTH;
+        p_pending->count--;
+    }
+    p_pending->events[p_pending->head] =                            *p_msg;
+    p_pending->count                   =                                 1;
+    p_masks->pending[__MASK_WORD(p_msg->index)] |= __MASK_BIT(p_msg->index);
+
+    // 2. a led only held by its group has no command of its own to stop.
+    if ( LED_PHASE_IDLE == p_led_instance->blink_state.phase )
+    {
+        return;
+    }
+    led_driver_boundary_get(p_led_instance,
+                            __time_now_us(self),
+                            LED_POLICY_CYCLE_END == p_msg->policy,
+                            &(self->engine.replace_us[p_msg->index]));
+    p_masks->replacing[__MASK_WORD(p_msg->index)] |=
+                                                  __MASK_BIT(p_msg->index);
+    __engine_sync(self, p_msg->index);
+    DEBUG_OUT("Info: The led is busy, the event replaces its command!\r\n");
+}
+
 static led_handler_status_t __event_process(
                             bsp_led_handler_t *const self,
                             led_event_t       *const p_msg
@@ -133,6 +610,7 @@ static led_handler_status_t __event_process(
 {
     led_handler_status_t ret = HANDLER_OK;
     bsp_led_driver_t *p_led_instance = NULL;
+    led_pending_t    *p_pending      = NULL;
     DEBUG_OUT("Info: Enter __event_process!\r\n");
 
     if ( NULL == self || NULL == p_msg )
@@ -142,11 +620,9 @@ static led_handler_status_t __event_process(
         return ret;
     }
 
-    if ((p_msg->index < LED_HANDLER_NO_1                    ||
+    if ( p_msg->index < LED_HANDLER_NO_1                    ||
          p_msg->index >= self->instances.led_instance_count ||
          p_msg->index >= MAX_INSTANCE_NUBER
-        )                                                   &&
-         p_msg->index != LED_NOT_INITIALIZED 
        )
     {
         DEBUG_OUT("Error: The led index is invalid!\r\n");
@@ -160,22 +636,46 @@ static led_handler_status_t __event_process(
         ret = HANDLER_ERRORRESOURCE;
         return ret;
     }
-    DEBUG_OUT("Info: Cycle time = %d, Blink times = %d, Proportion = %d\r\n",
-              p_msg->cycle_time_ms,
-              p_msg->blink_times,
-              p_msg->proportion_on_off);
     p_led_instance = self->instances.p_led_instance_group[p_msg->index];
-    p_led_instance->cycle_time_ms     =     p_msg->cycle_time_ms;
-    p_led_instance->blink_times       =       p_msg->blink_times;
-    p_led_instance->proportion_on_off = p_msg->proportion_on_off;
+    p_pending      = &(self->pending[p_msg->index]);
 
-    if ( HANDLER_OK != led_blink(
-                    self->instances.p_led_instance_group[p_msg->index]
-                                )
+    // the led is still blinking, or its group plays, hold the event 
+    // until it becomes idle.
+    if ( LED_PHASE_IDLE != p_led_instance->blink_state.phase ||
+         0              != p_pending->count                  ||
+         0              != (self->engine.masks[
+                                self->thread_pool.dispatch[p_msg->index]].
+                                grouped[__MASK_WORD(p_msg->index)] &
+                                                __MASK_BIT(p_msg->index))
        )
+    {
+        if ( LED_POLICY_QUEUE != p_msg->policy )
+        {
+            __event_replace(self, p_msg);
+            return ret;
+        }
+        if ( LED_HANDLER_PENDING_DEPTH <= p_pending->count )
+        {
+            DEBUG_OUT("Error: The pending events of led are full!\r\n");
+            ret = HANDLER_ERRORNOMEMORY;
+            __event_complete(p_led_instance, &(p_msg->completion),
+                             LED_ERRORNOMEMORY                   );
+            return ret;
+        }
+        p_pending->events[(p_pending->head + p_pending->count) %
+                                    LED_HANDLER_PENDING_DEPTH] = *p_msg;
+        p_pending->count++;
+        self->engine.masks[self->thread_pool.dispatch[p_msg->index]].
+                    pending[__MASK_WORD(p_msg->index)] |= 
+                                                __MASK_BIT(p_msg->index);
+        DEBUG_OUT("Info: The led is busy, the event is pending!\r\n");
+        return ret;
+    }
+
+    ret = __event_start(self, p_msg->index, p_msg, __time_now_us(self));
+    if ( HANDLER_OK != ret )
     {
         DEBUG_OUT("Error: The led blink failed!\r\n");
-        ret = HANDLER_ERRORRESOURCE;
         return ret;
     }
     DEBUG_OUT("Info: The led blink success!\r\n");
@@ -183,69 +683,538 @@ static led_handler_status_t __event_process(
     return ret;
     
 }
-static void handler_start_thread ( void * p_task_arg)
+/**
+ * @brief the body of one worker in the thread pool.
+ * 
+ * Every worker owns the leds dispatched to it, blocks on its own queue
+ * and ticks only its leds, so independent leds run in parallel.
+ *  
+ * @param[in] p_task_arg       : Pointer to the handler_worker_t.
+ * 
+ * */
+static void handler_worker_thread ( void * p_task_arg)
 {
     osDelay(2000);
-    DEBUG_OUT("Info: Enter handler_start_thread!\r\n");
+    DEBUG_OUT("Info: Enter handler_worker_thread!\r\n");
     /******************0.check target status******************/
     led_handler_status_t ret = HANDLER_OK;
+    handler_worker_t  * p_worker      = NULL;
     bsp_led_handler_t * p_led_handler = NULL;
     led_event_t         message       = {0U} ;
-    static uint32_t thread_count      = 0   ;
+    uint32_t            timeout_ms    = LED_HANDLER_WAIT_FOREVER;
     /***************1.Check the input parameter***************/
-    if ( NULL != p_task_arg )
+    if ( NULL == p_task_arg )
+    {
+        DEBUG_OUT("Error: The worker of thread is invalid!\r\n");
+        return;
+    }
+    p_worker      = (handler_worker_t *) p_task_arg;
+    p_led_handler = p_worker->p_handler;
+
+    /***************2.Start the worker ***********************/
+    for (;;)
+    {
+        // 2-1. sleep until a command arrives or the next deadline is due.
+        //      the OS tick is 1 ms, so timeout_ms is passed as ticks.
+        ret = p_led_handler->p_os_queue_instance->pf_os_queue_get(  
+                                        p_worker->p_queue_handler,
+                                        (void *)&message         ,
+                                        timeout_ms
+                                                                 );
+        // 2-2. drain every pending command in one go, the command leaves
+        //      the count of its led once it is in the engine masks.
+        while ( HANDLER_OK == ret )
+        {
+            __event_process(p_led_handler, &message);
+            p_led_handler->p_os_critical->pf_os_critical_enter();
+            p_led_handler->thread_pool.queued[message.index]--;
+            p_led_handler->p_os_critical->pf_os_critical_exit();
+            DEBUG_OUT("Info: Get the message from the led queue!\r\n");
+            ret = p_led_handler->p_os_queue_instance->pf_os_queue_get(  
+                                        p_worker->p_queue_handler,
+                                        (void *)&message         ,
+                                        0
+                                                                     );
+        }
+
+        // 2-3. advance the expired leds and get the next sleep time.
+        __engine_tick(p_led_handler, p_worker->worker_id, &timeout_ms);
+    }
+
+}
+
+/**
+ * @brief send the event to the queue of the worker which owns the led.
+ *  
+ * @param[in] self        : Pointer to the target of handler.
+ * @param[in] p_event     : the event, its index has been checked.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t __event_post(
+                            bsp_led_handler_t *const    self,
+                            led_event_t       *const p_event
+                                        )
+{
+    led_handler_status_t ret      = HANDLER_OK;
+    handler_worker_t    *p_worker = NULL;
+
+    DEBUG_OUT("Info: Send the event to the led queue!\r\n");
+    // the worker is read and the command counted at once, so a group never
+    // moves the led away from a command still in the queue.
+    self->p_os_critical->pf_os_critical_enter();
+    p_worker = &(self->thread_pool.workers[
+                                self->thread_pool.dispatch[p_event->index]]);
+    self->thread_pool.queued[p_event->index]++;
+    self->p_os_critical->pf_os_critical_exit();
+    ret = self->p_os_queue_instance->pf_os_queue_put(p_worker->p_queue_handler,
+                                                     (void *)p_event          ,
+                                                     0                       );
+    if (HANDLER_OK != ret)
+    {
+        DEBUG_OUT("Error: Send the event to the led queue failed!\r\n");
+        self->p_os_critical->pf_os_critical_enter();
+        self->thread_pool.queued[p_event->index]--;
+        self->p_os_critical->pf_os_critical_exit();
+    }
+
+    return ret;
+}
+
+/**
+ * @brief convert the cycle of a ms request to the time base of the engine.
+ * 
+ * @param[in] cycle_time_ms    : The whole time of blink[ms].
+ * 
+ * @return uint32_t : The cycle[us], LED_CYCLE_US_MAX if it is too long, so
+ *                    the product never wraps into the valid range.
+ * 
+ * */
+static uint32_t __cycle_ms_to_us(const uint32_t cycle_time_ms)
+{
+    if ( cycle_time_ms >= LED_CYCLE_US_MAX / LED_US_PER_MS )
+    {
+        return LED_CYCLE_US_MAX;
+    }
+
+    return cycle_time_ms * LED_US_PER_MS;
+}
+
+/**
+ * @brief check the values of a blink request.
+ * 
+ * @param[in] shape            : The shape of brightness in one cycle.
+ * @param[in] cycle_time_us    : The whole time of blink[us].
+ * @param[in] blink_times      : The times of blink.
+ * @param[in] duty             : The duty of led on, Q16 of LED_DUTY_FULL.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t __blink_check (
+                          const led_wave_shape_t         shape            ,
+                          const uint32_t                 cycle_time_us    , 
+                          const uint32_t                 blink_times      , 
+                          const led_duty_t                            duty 
+                                          )
+{
+    led_handler_status_t ret = HANDLER_OK;
+
+    if (
+        (cycle_time_us     <=  0                   ) ||
+        (cycle_time_us     >= LED_CYCLE_US_MAX     ) ||
+        (blink_times       <=  0                   ) ||
+        (blink_times       >= 1000                 ) ||
+        (duty              >  LED_DUTY_FULL        ) ||
+        (shape             >= LED_WAVE_NUM         )
+       )
+    {
+        DEBUG_OUT("Error: handler_led_control Parameter error!\r\n");
+        ret = HANDLER_ERRORPARAMETER;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief check a blink request and send it to the worker of the led.
+ * 
+ * Steps:
+ * 1. check the status of target and the input parameter.
+ * 2. send the blink event to the worker of the led.
+ *  
+ * @param[in] self             : Pointer to the target of handler.
+ * @param[in] index            : The index of led in the handler.
+ * @param[in] shape            : The shape of brightness in one cycle.
+ * @param[in] cycle_time_us    : The whole time of blink[us].
+ * @param[in] blink_times      : The times of blink.
+ * @param[in] duty             : The duty of led on, Q16 of LED_DUTY_FULL.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t __blink_post (
+                                bsp_led_handler_t *const self             ,
+                          const led_index_t              index            ,
+                          const led_wave_shape_t         shape            ,
+                          const uint32_t                 cycle_time_us    , 
+                          const uint32_t                 blink_times      , 
+                          const led_duty_t                            duty 
+                                         )
+{
+    led_handler_status_t ret      = HANDLER_OK;
+    /******************0.check target status******************/
+    // 0-1. check if the point is valid.
+    if ( NULL == self                           ||
+         HANDLER_NOT_INITED == self->is_inited
+       )
+    {
+        DEBUG_OUT("Error: The handler has not been initialized!\r\n");
+        ret = HANDLER_ERRORRESOURCE;
+        return ret;
+    }
+
+    /***************1.Check the input parameter***************/
+    // 1-1. check if the led handler[index] is valid.
+    if ( index < LED_HANDLER_NO_1                    ||
+         index >= self->instances.led_instance_count ||
+         index >= MAX_INSTANCE_NUBER
+       )
+    {
+        DEBUG_OUT("Error: The led index is invalid!\r\n");
+        ret = HANDLER_ERRORPARAMETER;
+        return ret;
+    }
+
+    // 1-2. check if they are valid values.
+    ret = __blink_check(shape, cycle_time_us, blink_times, duty);
+    if (HANDLER_OK != ret)
+    {
+        return ret;
+    }
+
+    /***************2.Send event to LED queue*****************/
+    // 2-1. create the event.
+    DEBUG_OUT("Info: Create a event!\r\n");
+    led_event_t led_event = 
+    {
+        .index             = index            ,
+        .type              = LED_EVENT_BLINK  ,
+        .cycle_time_us     = cycle_time_us    ,
+        .blink_times       = blink_times      ,
+        .duty              = duty             ,
+        .shape             = shape            ,
+    };
+    // 2-2. send the event to the led queue.
+    ret = __event_post(self, &led_event);
+    if (HANDLER_OK != ret)
+    {
+        return ret;
+    }
+
+    DEBUG_OUT("Info: led_control success!\r\n");
+    return ret;
+}
+
+/**
+ * @brief Link led_control to the enternal APIs of target.
+ * 
+ * Steps:
+ * 1. set external requirement values of target and do some actions.
+ * 2. add the data in target.
+ * 3. run the operation of target.
+ *  
+ * @param[in] self             : Pointer to the target of handler.
+ * @param[in] cycle_time_ms    : The whole time of blink.
+ * @param[in] blink_times      : The times of blink.
+ * @param[in] duty             : The duty of led on, Q16 of LED_DUTY_FULL.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t handler_led_control (
+                                bsp_led_handler_t *const self             ,
+                          const led_index_t              index            ,
+                          const uint32_t                 cycle_time_ms    , 
+                          const uint32_t                 blink_times      , 
+                          const led_duty_t                            duty 
+                                                )
+{
+    DEBUG_OUT("Info: Enter handler_led_control!\r\n");
+    return __blink_post(self, index, LED_WAVE_SQUARE, 
+                        __cycle_ms_to_us(cycle_time_ms), blink_times, duty);
+}
+
+/**
+ * @brief Link led_control_us to the enternal APIs of target.
+ * 
+ * The same as led_control with the cycle in microseconds. The edges of a
+ * sub-millisecond cycle are exact on a backend with pf_led_set_period, a
+ * software blink is served at the OS tick of the worker.
+ *  
+ * @param[in] self             : Pointer to the target of handler.
+ * @param[in] index            : The index of led in the handler.
+ * @param[in] cycle_time_us    : The whole time of blink[us].
+ * @param[in] blink_times      : The times of blink.
+ * @param[in] duty             : The duty of led on, Q16 of LED_DUTY_FULL.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t handler_led_control_us (
+                                bsp_led_handler_t *const self             ,
+                          const led_index_t              index            ,
+                          const uint32_t                 cycle_time_us    , 
+                          const uint32_t                 blink_times      , 
+                          const led_duty_t                            duty 
+                                                   )
+{
+    DEBUG_OUT("Info: Enter handler_led_control_us!\r\n");
+    return __blink_post(self, index, LED_WAVE_SQUARE, 
+                        cycle_time_us, blink_times, duty);
+}
+
+/**
+ * @brief Link led_wave to the enternal APIs of target.
+ * 
+ * The led breathes or fades along the shape with duty frames, so it 
+ * needs a duty-cycle backend.
+ *  
+ * @param[in] self             : Pointer to the target of handler.
+ * @param[in] index            : The index of led in the handler.
+ * @param[in] shape            : The shape of brightness in one cycle.
+ * @param[in] cycle_time_ms    : The whole time of one cycle.
+ * @param[in] blink_times      : The times of cycle.
+ * @param[in] peak             : The peak duty, Q16 of LED_DUTY_FULL.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t handler_led_wave (
+                                bsp_led_handler_t *const self             ,
+                          const led_index_t              index            ,
+                          const led_wave_shape_t         shape            ,
+                          const uint32_t                 cycle_time_ms    , 
+                          const uint32_t                 blink_times      , 
+                          const led_duty_t                            peak 
+                                             )
+{
+    DEBUG_OUT("Info: Enter handler_led_wave!\r\n");
+    return __blink_post(self, index, shape, 
+                        __cycle_ms_to_us(cycle_time_ms), blink_times, peak);
+}
+
+/**
+ * @brief Link led_brightness to the enternal APIs of target.
+ * 
+ * Steps:
+ * 1. check the status of target and the input parameter.
+ * 2. send the brightness event to the worker of the led.
+ * 
+ * The level is applied by the worker once the led is idle, so it never
+ * races with the blink engine of the led.
+ *  
+ * @param[in] self             : Pointer to the target of handler.
+ * @param[in] index            : The index of led in the handler.
+ * @param[in] level            : Perceptual brightness level, 0 is off and 
+ *                               255 is full on, gamma corrected by table.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t handler_led_brightness (
+                                bsp_led_handler_t *const self ,
+                          const led_index_t              index,
+                          const uint8_t                  level
+                                                   )
+{
+    led_handler_status_t ret = HANDLER_OK;
+    DEBUG_OUT("Info: Enter handler_led_brightness!\r\n");
+    /******************0.check target status******************/
+    if ( NULL == self                           ||
+         HANDLER_NOT_INITED == self->is_inited
+       )
+    {
+        DEBUG_OUT("Error: The handler has not been initialized!\r\n");
+        ret = HANDLER_ERRORRESOURCE;
+        return ret;
+    }
+
+    /***************1.Check the input parameter***************/
+    if ( index < LED_HANDLER_NO_1                    ||
+         index >= self->instances.led_instance_count ||
+         index >= MAX_INSTANCE_NUBER
+       )
+    {
+        DEBUG_OUT("Error: The led index is invalid!\r\n");
+        ret = HANDLER_ERRORPARAMETER;
+        return ret;
+    }
+
+    /***************2.Send event to LED queue*****************/
+    led_event_t led_event = 
+    {
+        .index             = index               ,
+        .type              = LED_EVENT_BRIGHTNESS,
+        .brightness        = level               ,
+    };
+    ret = __event_post(self, &led_event);
+
+    return ret;
+}
+
+/**
+ * @brief Link led_pattern to the enternal APIs of target.
+ * 
+ * Steps:
+ * 1. check the status of target and the input parameter.
+ * 2. send the pattern event to the worker of the led.
+ * 
+ * Only the pointer is queued, the ops are read from flash by the blink
+ * engine of the led while the pattern is played.
+ *  
+ * @param[in] self             : Pointer to the target of handler.
+ * @param[in] index            : The index of led in the handler.
+ * @param[in] p_pattern        : The const pattern, see bsp_led_pattern.h.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t handler_led_pattern (
+                                bsp_led_handler_t *const      self,
+                          const led_index_t                  index,
+                          const led_pattern_op_t *const  p_pattern
+                                                )
+{
+    led_handler_status_t ret = HANDLER_OK;
+    DEBUG_OUT("Info: Enter handler_led_pattern!\r\n");
+    /******************0.check target status******************/
+    if ( NULL == self                           ||
+         HANDLER_NOT_INITED == self->is_inited
+       )
+    {
+        DEBUG_OUT("Error: The handler has not been initialized!\r\n");
+        ret = HANDLER_ERRORRESOURCE;
+        return ret;
+    }
+
+    /***************1.Check the input parameter***************/
+    if ( index < LED_HANDLER_NO_1                    ||
+         index >= self->instances.led_instance_count ||
+         index >= MAX_INSTANCE_NUBER                 ||
+         NULL  == p_pattern
+       )
+    {
+        DEBUG_OUT("Error: handler_led_pattern Parameter error!\r\n");
+        ret = HANDLER_ERRORPARAMETER;
+        return ret;
+    }
+
+    /***************2.Send event to LED queue*****************/
+    led_event_t led_event = 
+    {
+        .index             = index            ,
+        .type              = LED_EVENT_PATTERN,
+        .p_pattern         = p_pattern        ,
+    };
+    ret = __event_post(self, &led_event);
+
+    return ret;
+}
+
+/**
+ * @brief Link led_timeline to the enternal APIs of target.
+ * 
+ * Steps:
+ * 1. check the status of target and the input parameter.
+ * 2. send the timeline event to the worker of the led.
+ * 
+ * The event replaces what the led plays at once, so a seek, a pause and
+ * a resume of a show take effect without waiting for its end. A pause
+ * holds the duty of the position, and LED_TIMELINE_RESUME plays on from
+ * there. Only the pointer is queued, the keyframes stay in flash.
+ *  
+ * @param[in] self             : Pointer to the target of handler.
+ * @param[in] index            : The index of led in the handler.
+ * @param[in] p_timeline       : The const timeline, see bsp_led_timeline.h,
+ *                               NULL to pause the one being played.
+ * @param[in] pos_ms           : Position[ms] to play it from, or
+ *                               LED_TIMELINE_RESUME.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t handler_led_timeline (
+                                bsp_led_handler_t *const      self,
+                          const led_index_t                  index,
+                          const led_timeline_t   *const p_timeline,
+                          const uint32_t                    pos_ms
+                                                 )
+{
+    led_handler_status_t ret = HANDLER_OK;
+    DEBUG_OUT("Info: Enter handler_led_timeline!\r\n");
+    /******************0.check target status******************/
+    if ( NULL == self                           ||
+         HANDLER_NOT_INITED == self->is_inited
+       )
+    {
+        DEBUG_OUT("Error: The handler has not been initialized!\r\n");
+        ret = HANDLER_ERRORRESOURCE;
+        return ret;
+    }
+
+    /***************1.Check the input parameter***************/
+    if ( index < LED_HANDLER_NO_1                    ||
+         index >= self->instances.led_instance_count ||
+         index >= MAX_INSTANCE_NUBER
+       )
     {
-        p_led_handler = (bsp_led_handler_t *) p_task_arg;
+        DEBUG_OUT("Error: handler_led_timeline Parameter error!\r\n");
+        ret = HANDLER_ERRORPARAMETER;
+        return ret;
     }
 
-    /***************2.Start first thread *********************/
-    for (;;)
+    /***************2.Send event to LED queue*****************/
+    led_event_t led_event = 
     {
-        thread_count++;
-        ret = p_led_handler->p_os_queue_instance->pf_os_queue_get(  
-                                        p_led_handler->p_os_queue_handler,
-                                        (void *)&message                 ,
-                                        0
-                                                                 );
-        if ( HANDLER_OK == ret )
-        {
-            __event_process(p_led_handler, &message);
-            DEBUG_OUT("Info: Get the message from the led queue!\r\n");
-        }
-
-        osDelay(1000);
-    }
+        .index             = index             ,
+        .type              = LED_EVENT_TIMELINE,
+        .p_timeline        = p_timeline        ,
+        .timeline_ms       = pos_ms            ,
+        .policy            = LED_POLICY_NOW    ,
+    };
+    ret = __event_post(self, &led_event);
 
+    return ret;
 }
 
 /**
- * @brief Link led_control to the enternal APIs of target.
+ * @brief Link the request of any type to the enternal APIs of target.
  * 
  * Steps:
- * 1. set external requirement values of target and do some actions.
- * 2. add the data in target.
- * 3. run the operation of target.
+ * 1. check the status of target and the request.
+ * 2. send the request to the worker of the led.
+ * 
+ * Unlike the other APIs, the policy of the request is chosen by the 
+ * caller, e.g. LED_POLICY_NOW lets a long blink be replaced at its next
+ * edge instead of waiting for its end.
  *  
  * @param[in] self             : Pointer to the target of handler.
- * @param[in] cycle_time_ms    : The whole time of blink.
- * @param[in] blink_times      : The times of blink.
- * @param[in] proportion_on_off: The proportion ralationship of led on and off.
+ * @param[in] p_request        : The request, its completion is optional.
  * 
  * @return led_handler_status_t : Status of the function.
  * 
  * */
-static led_handler_status_t handler_led_control (
-                                bsp_led_handler_t *const self             ,
-                          const led_index_t              index            ,
-                          const uint32_t                 cycle_time_ms    , 
-                          const uint32_t                 blink_times      , 
-                          const proportion_t             proportion_on_off 
+static led_handler_status_t handler_led_request (
+                                bsp_led_handler_t *const      self,
+                          const led_event_t       *const p_request
                                                 )
 {
-    led_handler_status_t ret = HANDLER_OK;
-    DEBUG_OUT("Info: Enter handler_led_control!\r\n");
+    led_handler_status_t ret       = HANDLER_OK;
+    led_event_t          led_event;
+    DEBUG_OUT("Info: Enter handler_led_request!\r\n");
     /******************0.check target status******************/
-    // 0-1. check if the point is valid.
     if ( NULL == self                           ||
          HANDLER_NOT_INITED == self->is_inited
        )
@@ -256,55 +1225,122 @@ static led_handler_status_t handler_led_control (
     }
 
     /***************1.Check the input parameter***************/
-    // 1-1. check if the led handler[index] is valid.
-    if ( index < LED_HANDLER_NO_1                    ||
-         index >= self->instances.led_instance_count ||
-         index >= MAX_INSTANCE_NUBER
+    if ( NULL == p_request                                      ||
+         p_request->index  <  LED_HANDLER_NO_1                  ||
+         p_request->index  >= self->instances.led_instance_count ||
+         p_request->index  >= MAX_INSTANCE_NUBER                ||
+         p_request->policy >= LED_POLICY_NUM
        )
     {
-        DEBUG_OUT("Error: The led index is invalid!\r\n");
+        DEBUG_OUT("Error: handler_led_request Parameter error!\r\n");
         ret = HANDLER_ERRORPARAMETER;
         return ret;
     }
 
-    // 1-2. check if they are valid values.
-    if (
-        (cycle_time_ms     <=  0                   ) ||
-        (cycle_time_ms     >= 10000                ) ||
-        (blink_times       <=  0                   ) ||
-        (blink_times       >= 1000                 ) ||
-        (proportion_on_off <  PROPORTION_ON_OFF_1_1) ||
-        (proportion_on_off >= PROPORTION_ON_OFF_NUM)
-       )
+    switch (p_request->type)
     {
-        DEBUG_OUT("Error: handler_led_control Parameter error!\r\n");
-        ret = HANDLER_ERRORPARAMETER;
+        case LED_EVENT_BLINK:
+            ret = __blink_check(p_request->shape,
+                                p_request->cycle_time_us,
+                                p_request->blink_times,
+                                p_request->duty);
+            break;
+        case LED_EVENT_BRIGHTNESS:
+            break;
+        case LED_EVENT_PATTERN:
+            if ( NULL == p_request->p_pattern )
+            {
+                ret = HANDLER_ERRORPARAMETER;
+            }
+            break;
+        case LED_EVENT_TIMELINE:
+            break;
+        default:
+            ret = HANDLER_ERRORPARAMETER;
+            break;
+    }
+    if (HANDLER_OK != ret)
+    {
+        DEBUG_OUT("Error: handler_led_request Parameter error!\r\n");
         return ret;
     }
 
     /***************2.Send event to LED queue*****************/
-    // 2-1. create the event.
-    DEBUG_OUT("Info: Create a event!\r\n");
-    led_event_t led_event = 
+    led_event = *p_request;
+    ret = __event_post(self, &led_event);
+
+    return ret;
+}
+
+/**
+ * @brief post a blink request of the registered led, mounted in the led
+ *        driver as pf_submit by led_register.
+ * 
+ * Steps:
+ * 1. find the index of the led in the handler.
+ * 2. send the event with its completion to the worker of the led.
+ *  
+ * @param[in] p_owner          : Pointer to the handler which owns the led.
+ * @param[in] led              : Pointer to the led.
+ * @param[in] cycle_time_ms    : The whole time of blink.
+ * @param[in] blink_times      : The times of blink.
+ * @param[in] duty             : The duty of led on, Q16 of LED_DUTY_FULL.
+ * @param[in] p_completion     : Completion of the request, NULL allowed.
+ * 
+ * @return led_status_t : Status of the function, the handler status is 
+ *                        returned as it has the same values.
+ * 
+ * */
+static led_status_t __led_submit (
+                                void              *const p_owner          ,
+                                bsp_led_driver_t  *const led              ,
+                          const uint32_t                 cycle_time_ms    , 
+                          const uint32_t                 blink_times      , 
+                          const led_duty_t                            duty,
+                          const led_completion_t  *const p_completion
+                                 )
+{
+    led_handler_status_t ret  = HANDLER_ERRORRESOURCE;
+    bsp_led_handler_t   *self = (bsp_led_handler_t *)p_owner;
+
+    if ( NULL == self                           ||
+         HANDLER_NOT_INITED == self->is_inited
+       )
     {
-        .index             = index            ,
-        .cycle_time_ms     = cycle_time_ms    ,
-        .blink_times       = blink_times      ,
-        .proportion_on_off = proportion_on_off,
-    };
-    // 2-2. send the event to the led queue.
-    DEBUG_OUT("Info: Send the event to the led queue!\r\n");
-    ret = self->p_os_queue_instance->pf_os_queue_put(self->p_os_queue_handler,
-                                                     (void *)&led_event      ,
-                                                     0                      );
-    if (HANDLER_OK != ret)
+        DEBUG_OUT("Error: The handler has not been initialized!\r\n");
+        return (led_status_t)ret;
+    }
+
+    /***************1.Find the index of the led***************/
+    for ( uint32_t led_number = 0;
+          led_number < self->instances.led_instance_count;
+          ++ led_number
+        )
     {
-        DEBUG_OUT("Error: Send the event to the led queue failed!\r\n");
-        return ret;
+        if ( led != self->instances.p_led_instance_group[led_number] )
+        {
+            continue;
+        }
+
+        /***************2.Send event to LED queue*****************/
+        led_event_t led_event = 
+        {
+            .index             = (led_index_t)led_number,
+            .type              = LED_EVENT_BLINK        ,
+            .cycle_time_us     = __cycle_ms_to_us(cycle_time_ms),
+            .blink_times       = blink_times            ,
+            .duty              = duty                   ,
+        };
+        if ( NULL != p_completion )
+        {
+            led_event.completion = *p_completion;
+        }
+        ret = __event_post(self, &led_event);
+        return (led_status_t)ret;
     }
 
-    DEBUG_OUT("Info: led_control success!\r\n");
-    return ret;
+    DEBUG_OUT("Error: The led is not registered to the handler!\r\n");
+    return (led_status_t)ret;
 }
 
 /**
@@ -327,7 +1363,8 @@ static led_handler_status_t led_register (
                                 led_index_t       *const index 
                                          )
 {
-    led_handler_status_t ret = HANDLER_OK;
+    led_handler_status_t ret          = HANDLER_OK;
+    bsp_led_driver_t    *p_registered = NULL;
     /************1.check the status of target************/
 
     if ( NULL == self                           ||
@@ -371,15 +1408,390 @@ static led_handler_status_t led_register (
     {
         self->instances.p_led_instance_group[                        \
                             self->instances.led_instance_count] = led;
+#ifdef OS_SUPPORTING
+        // spread the leds over the workers of the pool, but the leds of
+        // one backend go to one worker, so its flush, e.g. the swap of a
+        // framebuffer, has a single producer.
+        self->thread_pool.dispatch[self->instances.led_instance_count] = 
+                            (uint8_t)(self->instances.led_instance_count %
+                                      self->thread_pool.worker_count);
+        for ( uint32_t led_number = 0;
+              led_number < self->instances.led_instance_count;
+              ++ led_number
+            )
+        {
+            p_registered = self->instances.p_led_instance_group[led_number];
+            if ( NULL != led->p_led_opes->pf_led_flush                     &&
+                 led->p_led_opes->pf_led_flush == 
+                                    p_registered->p_led_opes->pf_led_flush
+               )
+            {
+                self->thread_pool.dispatch[
+                                self->instances.led_instance_count] =
+                                self->thread_pool.dispatch[led_number];
+                break;
+            }
+        }
+#endif // End of OS_SUPPORTING
         *index = self->instances.led_instance_count;
         self->instances.led_instance_count++;
+#ifdef OS_SUPPORTING
+        // let the async API of the led post its requests to the handler.
+        led->p_owner   =         self;
+        led->pf_submit = __led_submit;
+#endif // End of OS_SUPPORTING
+    }
+#ifdef OS_SUPPORTING
+    self->p_os_critical->pf_os_critical_exit();
+#endif // End of OS_SUPPORTING
+
+    return ret;
+}
+
+/**
+ * @brief move the led, and the leds which share its flush, to the worker.
+ * 
+ * @param[in] self        : Pointer to the target of handler.
+ * @param[in] led_number  : the index of the led.
+ * @param[in] worker_id   : the worker which owns the led from now on.
+ * 
+ * */
+static void __dispatch_move(
+                            bsp_led_handler_t *const           self,
+                      const uint32_t                     led_number,
+                      const uint8_t                       worker_id
+                           )
+{
+    led_status_t (*pf_flush)(void) = 
+        self->instances.p_led_instance_group[led_number]->
+                                            p_led_opes->pf_led_flush;
+
+    for ( uint32_t number = LED_HANDLER_NO_1;
+          number < self->instances.led_instance_count;
+          ++ number
+        )
+    {
+        if ( number == led_number                                  ||
+             ( NULL     != pf_flush                                &&
+               pf_flush == self->instances.p_led_instance_group[number]->
+                                               p_led_opes->pf_led_flush )
+           )
+        {
+            self->thread_pool.dispatch[number] = worker_id;
+        }
+    }
+}
+
+/**
+ * @brief check the led, and the leds which share its flush, could be moved
+ *        to the worker, see __dispatch_move().
+ * 
+ * The engine masks of a led stay with its old worker, so a led which 
+ * changes its worker must be idle, hold no command and have no command in
+ * the queue of the old worker, or two workers would drive it. A led which
+ * is on the worker already is not moved. Called in the critical section
+ * of the move.
+ * 
+ * @param[in] self        : Pointer to the target of handler.
+ * @param[in] led_number  : the index of the led, it must be idle.
+ * @param[in] worker_id   : the worker which would own the led.
+ * 
+ * @return uint32_t : 1 if the leds could be moved, else 0.
+ * 
+ * */
+static uint32_t __dispatch_movable(
+                            bsp_led_handler_t *const           self,
+                      const uint32_t                     led_number,
+                      const uint8_t                       worker_id
+                                  )
+{
+    bsp_led_driver_t *p_led    = NULL;
+    led_status_t    (*pf_flush)(void) = 
+        self->instances.p_led_instance_group[led_number]->
+                                            p_led_opes->pf_led_flush;
+
+    for ( uint32_t number = LED_HANDLER_NO_1;
+          number < self->instances.led_instance_count;
+          ++ number
+        )
+    {
+        p_led = self->instances.p_led_instance_group[number];
+        if ( number != led_number                              &&
+             ( NULL     == pf_flush                            ||
+               pf_flush != p_led->p_led_opes->pf_led_flush     ||
+               worker_id == self->thread_pool.dispatch[number] )
+           )
+        {
+            continue;
+        }
+        if ( LED_PHASE_IDLE != p_led->blink_state.phase ||
+             0              != self->pending[number].count  ||
+             0              != self->thread_pool.queued[number]
+           )
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief create a group of leds which blink in phase, driven by one blink
+ *        engine.
+ * 
+ * Steps:
+ * 1. check the status of target and the members.
+ * 2. move the members and the leds which share their flush to the worker
+ *    of the first member, in one critical section with the check that all
+ *    those to be moved are idle and have no command queued.
+ * 3. register the leader of the group as one more led, on the same worker.
+ * 
+ * The group is used by its index like any led, e.g. pf_handler_led_wave.
+ * On every output change of the leader, the members are written in one
+ * pass of one worker, so the members on one backend change at one flush.
+ * Create the groups at init, while the members are idle, the own commands
+ * of a member wait until its group is idle.
+ *  
+ * @param[in]  self          : Pointer to the target of handler.
+ * @param[in]  p_members     : The indexes of the members.
+ * @param[in]  member_num    : Number of the members.
+ * @param[out] p_group_index : The index of the group in the handler.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t handler_group_create (
+                                bsp_led_handler_t *const          self,
+                          const led_index_t       *const     p_members,
+                          const uint32_t                    member_num,
+                                led_index_t       *const p_group_index
+                                                 )
+{
+    led_handler_status_t ret      = HANDLER_OK;
+    handler_group_t     *p_group  = NULL;
+    bsp_led_driver_t    *p_member = NULL;
+    uint8_t              worker_id = 0;
+    DEBUG_OUT("Info: Enter handler_group_create!\r\n");
+    /******************0.check target status******************/
+    if ( NULL == self                           ||
+         HANDLER_NOT_INITED == self->is_inited
+       )
+    {
+        DEBUG_OUT("Error: The handler has not been initialized!\r\n");
+        ret = HANDLER_ERRORRESOURCE;
+        return ret;
+    }
+
+    if ( NULL == p_members || 0 == member_num || NULL == p_group_index )
+    {
+        DEBUG_OUT("Error: handler_group_create Parameter error!\r\n");
+        ret = HANDLER_ERRORPARAMETER;
+        return ret;
+    }
+
+    if ( LED_HANDLER_GROUP_NUM <= self->group_count )
+    {
+        DEBUG_OUT("Error: The groups of handler are full!\r\n");
+        ret = HANDLER_ERRORNOMEMORY;
+        return ret;
+    }
+
+    /***************1.Check the members***********************/
+    for ( uint32_t member = 0; member < member_num; ++ member )
+    {
+        if ( p_members[member] <  LED_HANDLER_NO_1                    ||
+             p_members[member] >= self->instances.led_instance_count  ||
+             0 != (self->group_mask[__MASK_WORD(p_members[member])]   &
+                                    __MASK_BIT(p_members[member]))
+           )
+        {
+            DEBUG_OUT("Error: The member of group is invalid!\r\n");
+            ret = HANDLER_ERRORPARAMETER;
+            return ret;
+        }
+    }
+
+    /***************2.Move the members to one worker**********/
+    // the members and their flush-mates go to the first member.
+#ifdef OS_SUPPORTING
+    self->p_os_critical->pf_os_critical_enter();
+#endif // End of OS_SUPPORTING
+    worker_id = self->thread_pool.dispatch[p_members[0]];
+    for ( uint32_t member = 0; member < member_num; ++ member )
+    {
+        if ( 0 == __dispatch_movable(self, p_members[member], worker_id) )
+        {
+#ifdef OS_SUPPORTING
+            self->p_os_critical->pf_os_critical_exit();
+#endif // End of OS_SUPPORTING
+            DEBUG_OUT("Error: The member of group, or a led on its flush, "
+                      "is not idle!\r\n");
+            ret = HANDLER_ERRORRESOURCE;
+            return ret;
+        }
+    }
+    for ( uint32_t member = 0; member < member_num; ++ member )
+    {
+        __dispatch_move(self, p_members[member], worker_id);
+    }
+#ifdef OS_SUPPORTING
+    self->p_os_critical->pf_os_critical_exit();
+#endif // End of OS_SUPPORTING
+
+    /***************3.Register the leader*********************/
+    p_group  = &(self->groups[self->group_count]);
+    p_member = self->instances.p_led_instance_group[p_members[0]];
+    memset(p_group, 0, sizeof(*p_group));
+    // the first write of the group always reaches the members.
+    p_group->output = LED_DUTY_INVALID;
+    if ( LED_OK != led_driver_inst(&(p_group->leader),
+#ifdef OS_SUPPORTING
+                                   p_member->p_os_delay,
+#endif // End of OS_SUPPORTING
+                                   &__group_ops,
+                                   p_member->p_time_base) )
+    {
+        DEBUG_OUT("Error: The leader of group init failed!\r\n");
+        ret = HANDLER_ERRORRESOURCE;
+        return ret;
+    }
+    ret = led_register(self, &(p_group->leader), p_group_index);
+    if ( HANDLER_OK != ret )
+    {
+        return ret;
+    }
+
+#ifdef OS_SUPPORTING
+    self->p_os_critical->pf_os_critical_enter();
+#endif // End of OS_SUPPORTING
+    self->thread_pool.dispatch[*p_group_index] = worker_id;
+    for ( uint32_t member = 0; member < member_num; ++ member )
+    {
+        p_group->members[__MASK_WORD(p_members[member])] |= 
+                                        __MASK_BIT(p_members[member]);
     }
+    self->group_mask[__MASK_WORD(*p_group_index)] |= 
+                                        __MASK_BIT(*p_group_index);
+    self->group_count++;
 #ifdef OS_SUPPORTING
     self->p_os_critical->pf_os_critical_exit();
 #endif // End of OS_SUPPORTING
 
+    // the members on a duty-cycle backend dim at a flicker free period.
+    for ( uint32_t member = 0; member < member_num; ++ member )
+    {
+        led_driver_dim_period_set(
+                    self->instances.p_led_instance_group[p_members[member]]);
+    }
+
+    return ret;
+}
+
+#ifdef OS_SUPPORTING
+/**
+ * @brief release the queues and threads of the pool which have been created.
+ *  
+ * @param[in] self        : Pointer to the target of the led handler.
+ * 
+ * */
+static void __thread_pool_deinit(bsp_led_handler_t *const self)
+{
+    handler_worker_t *p_worker = NULL;
+
+    for ( uint32_t worker_id = 0; 
+          worker_id < LED_HANDLER_WORKER_NUM; 
+          ++ worker_id
+        )
+    {
+        p_worker = &(self->thread_pool.workers[worker_id]);
+        if ( NULL != p_worker->p_thread_handler )
+        {
+            self->p_os_thread_instance->pf_os_thread_delete(
+                                            p_worker->p_thread_handler);
+            p_worker->p_thread_handler = NULL;
+        }
+        if ( NULL != p_worker->p_queue_handler )
+        {
+            self->p_os_queue_instance->pf_os_queue_delete(
+                                            p_worker->p_queue_handler);
+            p_worker->p_queue_handler  = NULL;
+        }
+    }
+    self->thread_pool.worker_count = 0;
+}
+
+/**
+ * @brief create the thread pool, each worker has its own queue.
+ * 
+ * Steps:
+ * 1. create the queue of the worker.
+ * 2. create the thread of the worker.
+ *  
+ * @param[in] self        : Pointer to the target of the led handler.
+ * 
+ * @return led_handler_status_t : Status of the function.
+ * 
+ * */
+static led_handler_status_t __thread_pool_init(bsp_led_handler_t *const self)
+{
+    led_handler_status_t ret      = HANDLER_OK;
+    handler_worker_t    *p_worker = NULL;
+    task_atrribute_t     worker_attribute = 
+    {
+#ifdef FREERTOS_SUPPORTING
+        .freeRTOS_attribute = 
+        {
+            .name        = "led_worker"                   ,
+            .stack_depth = LED_HANDLER_WORKER_STACK       ,
+            .priority    = (osPriority_t) osPriorityNormal,
+        }
+#else
+        0
+#endif // end of FREERTOS_SUPPORTING
+    };
+
+    memset(&(self->thread_pool), 0, sizeof(self->thread_pool));
+
+    for ( uint32_t worker_id = 0; 
+          worker_id < LED_HANDLER_WORKER_NUM; 
+          ++ worker_id
+        )
+    {
+        p_worker            = &(self->thread_pool.workers[worker_id]);
+        p_worker->p_handler =                                       self;
+        p_worker->worker_id =                                  worker_id;
+
+        // 1. the queue must exist before the worker runs.
+        ret = self->p_os_queue_instance->pf_os_queue_create(
+                                         LED_HANDLER_QUEUE_DEPTH     ,
+                                         sizeof(led_event_t)         ,
+                                       &(p_worker->p_queue_handler));
+        if (HANDLER_OK != ret)
+        {
+            DEBUG_OUT("Error: Create queue failed!\r\n");
+            __thread_pool_deinit(self);
+            return ret;
+        }
+
+        // 2. create the thread of the worker.
+        ret = self->p_os_thread_instance->pf_os_thread_create(
+                                           handler_worker_thread      ,
+                                           p_worker                   ,
+                                          &worker_attribute           ,
+                                         &(p_worker->p_thread_handler));
+        if (HANDLER_OK != ret)
+        {
+            DEBUG_OUT("Error: Create thread failed!\r\n");
+            __thread_pool_deinit(self);
+            return ret;
+        }
+        self->thread_pool.worker_count++;
+    }
+
     return ret;
 }
+#endif // End of OS_SUPPORTING
 
 /**
  * @brief the constructor of bsp_led_handler_t.
@@ -446,36 +1858,11 @@ led_handler_status_t led_handler_inst (
 
     /************4.Init the led group of target***************/
 #ifdef OS_SUPPORTING
-    // 4.1 init os thread that will be used.
-    /*
-    TBD:
-        I think there is one problem here, should create a thread pool, 
-        instead of create a thread.
-        And p_os_thread_handler only point to one thread.
-    */
-    ret = self->p_os_thread_instance->pf_os_thread_create(
-                                           handler_start_thread       ,
-                                           self                       ,
-                                           NULL                       ,
-                                         &(self->p_os_thread_handler));
-    if (HANDLER_OK != ret)
-    {
-        DEBUG_OUT("Error: Create thread failed!\r\n");
-        self->p_os_thread_instance->pf_os_thread_delete(self->p_os_thread_handler);
-        return ret;
-    }
-    // 4.1 init os queue that will be used.
-    ret = self->p_os_queue_instance->pf_os_queue_create(
-                                         10                          ,
-                                         sizeof(led_event_t)         ,
-                                       &(self->p_os_queue_handler));
+    // 4.1 init the thread pool and the queues of workers.
+    ret = __thread_pool_init(self);
     if (HANDLER_OK != ret)
     {
-        DEBUG_OUT("Error: Create queue failed!\r\n");
-        self->p_os_queue_instance->pf_os_queue_delete(
-                                            self->p_os_queue_handler);
-        self->p_os_thread_instance->pf_os_thread_delete(
-                                            self->p_os_thread_handler);
+        DEBUG_OUT("Error: Create thread pool failed!\r\n");
         return ret;
     }
 #endif // End of OS_SUPPORTING
@@ -483,21 +1870,33 @@ led_handler_status_t led_handler_inst (
     self->instances.led_instance_count =   LED_HANDLER_NO_1;
     ret = __array_init(self->instances.p_led_instance_group, 
                        MAX_INSTANCE_NUBER                 );
+    memset(self->pending, 0, sizeof(self->pending));
+    memset(self->running, 0, sizeof(self->running));
+    memset(&(self->engine), 0, sizeof(self->engine));
+    memset(self->groups, 0, sizeof(self->groups));
+    memset(self->group_mask, 0, sizeof(self->group_mask));
+    self->group_count = 0;
 
     /**************5.mount the enternal APIs*******************/
-    self->pf_handler_led_controler = handler_led_control;
-    self->pf_led_register          =        led_register;
+    self->pf_handler_led_controler  =    handler_led_control;
+    self->pf_handler_led_control_us = handler_led_control_us;
+    self->pf_handler_led_brightness = handler_led_brightness;
+    self->pf_handler_led_wave       =       handler_led_wave;
+    self->pf_handler_led_pattern    =    handler_led_pattern;
+    self->pf_handler_led_timeline   =   handler_led_timeline;
+    self->pf_handler_led_request    =    handler_led_request;
+    self->pf_handler_group_create   =   handler_group_create;
+    self->pf_led_register           =           led_register;
 
     if (HANDLER_OK != ret)
     {
         DEBUG_OUT("Error: Init led instance group failed!\r\n");
 
 #ifdef OS_SUPPORTING
+        __thread_pool_deinit(self);
         self->p_os_delay          = NULL;
         self->p_os_queue_instance = NULL;
         self->p_os_critical       = NULL;
-        self->p_os_thread_instance->pf_os_thread_delete(self->p_os_thread_handler);
-        self->p_os_queue_instance->pf_os_queue_delete(self->p_os_queue_handler);
 #endif // End of OS_SUPPORTING
         self->p_time_base         = NULL;
 
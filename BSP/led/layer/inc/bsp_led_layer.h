@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_layer.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ * - arm_math.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's compositing of stacked effect layers of the leds.
+ *
+ * Processing flow:
+ *
+ * led_layer_stack_init() -> led_layer_level_set() or led_layer_fill() by
+ * the effects of every layer -> led_layer_compose() once per frame.
+ *
+ * Every layer holds a Q15 level per led and a blend mode, and the stack
+ * is blended from the bottom layer up, e.g.
+ *
+ *   [0] status pattern, REPLACE
+ *   [1] alert overlay , REPLACE, LED_LAYER_CLEAR where there is no alert
+ *   [2] global dimmer , MULTIPLY
+ *
+ * so an alert covers the status of its leds without stopping it, and the
+ * status shows again as soon as the alert layer is cleared.
+ *
+ * ADD and MULTIPLY run over the whole led array in one call of the CMSIS-DSP
+ * kernels arm_add_q15() and arm_mult_q15(), saturated in Q15, but a led
+ * under a full MULTIPLY level is left out of the scaling. This version
+ * of CMSIS-DSP has no element-wise max, MAX and REPLACE are plain loops.
+ *
+ * @version V1.0 2025-06-20
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_LAYER_H__
+#define __BSP_LED_LAYER_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include "arm_math.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Layers of one stack                                                      */
+#ifndef LED_LAYER_NUM
+#define LED_LAYER_NUM                 (4U)
+#endif
+/* Leds of one stack, even, so the kernels read two levels per word        */
+#ifndef LED_LAYER_LED_NUM
+#define LED_LAYER_LED_NUM             (16U)
+#endif
+/* Level[Q15] of full brightness                                            */
+#define LED_LAYER_LEVEL_FULL          ((q15_t)0x7FFF)
+/* Level of a REPLACE layer where the layers below show through             */
+#define LED_LAYER_CLEAR               ((q15_t)0x8000)
+
+typedef enum
+{
+    LED_BLEND_REPLACE     =    0,   /* The layer covers the layers below.    */
+    LED_BLEND_ADD         =    1,   /* Added to the layers below, saturated. */
+    LED_BLEND_MULTIPLY    =    2,   /* Scales the layers below, a dimmer.    */
+    LED_BLEND_MAX         =    3,   /* The brighter of it and those below.   */
+    LED_BLEND_NUM,
+} led_blend_mode_t;
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* Level[Q15] of every led, first for the kernels  */
+    q15_t                         level[LED_LAYER_LED_NUM];
+    /* Blend mode of the layer onto those below        */
+    led_blend_mode_t                                  mode;
+    /* Non-zero if the layer takes part in the blend   */
+    uint32_t                                       enabled;
+} led_layer_t;
+
+typedef struct
+{
+    /* The layers, the bottom one first                */
+    led_layer_t                     layers[LED_LAYER_NUM];
+    /* Result[Q15] of the last compose                 */
+    q15_t                           output[LED_LAYER_LED_NUM];
+    /* Number of the layers                            */
+    uint32_t                                     layer_num;
+    /* Number of the leds                              */
+    uint32_t                                       led_num;
+    /* Non-zero if a layer changed since the compose   */
+    uint32_t                                         dirty;
+} led_layer_stack_t;
+
+/**
+ * @brief init the stack, every layer is enabled and clear.
+ *
+ * @param[out] p_stack     : The layer stack.
+ * @param[in]  p_modes     : Blend mode of every layer, the bottom first.
+ * @param[in]  layer_num   : Number of the layers, up to LED_LAYER_NUM.
+ * @param[in]  led_num     : Number of the leds, up to LED_LAYER_LED_NUM.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_layer_stack_init(
+                                  led_layer_stack_t  *const      p_stack,
+                            const led_blend_mode_t   *const      p_modes,
+                            const uint32_t                     layer_num,
+                            const uint32_t                       led_num
+                                 );
+
+/**
+ * @brief set the level of one led in one layer.
+ *
+ * @param[in] p_stack     : The layer stack.
+ * @param[in] layer       : Index of the layer.
+ * @param[in] led         : Index of the led.
+ * @param[in] level       : Level[Q15], or LED_LAYER_CLEAR.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_layer_level_set(
+                                  led_layer_stack_t  *const      p_stack,
+                            const uint32_t                         layer,
+                            const uint32_t                           led,
+                            const q15_t                            level
+                                );
+
+/**
+ * @brief set the level of every led in one layer, e.g. a global dimmer.
+ *
+ * @param[in] p_stack     : The layer stack.
+ * @param[in] layer       : Index of the layer.
+ * @param[in] level       : Level[Q15], or LED_LAYER_CLEAR.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_layer_fill(
+                                  led_layer_stack_t  *const      p_stack,
+                            const uint32_t                         layer,
+                            const q15_t                            level
+                           );
+
+/**
+ * @brief clear one layer, it leaves the layers below unchanged.
+ *
+ * Clear is LED_LAYER_CLEAR for REPLACE, 0 for ADD and MAX, and full for
+ * MULTIPLY, which keeps the level below as it is.
+ *
+ * @param[in] p_stack     : The layer stack.
+ * @param[in] layer       : Index of the layer.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_layer_clear(
+                                  led_layer_stack_t  *const      p_stack,
+                            const uint32_t                         layer
+                            );
+
+/**
+ * @brief take a layer in or out of the blend, its levels are kept.
+ *
+ * @param[in] p_stack     : The layer stack.
+ * @param[in] layer       : Index of the layer.
+ * @param[in] enabled     : Non-zero to blend the layer.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_layer_enable(
+                                  led_layer_stack_t  *const      p_stack,
+                            const uint32_t                         layer,
+                            const uint32_t                       enabled
+                             );
+
+/**
+ * @brief blend the enabled layers and get the duty of every led.
+ *
+ * @param[in]  p_stack     : The layer stack.
+ * @param[out] p_duty      : Duty of every led, led_num entries.
+ *
+ * @return uint32_t : 1 if the layers are blended, 0 if nothing changed.
+ *
+ * */
+uint32_t led_layer_compose(
+                                  led_layer_stack_t  *const      p_stack,
+                                  led_duty_t         *const       p_duty
+                          );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_LAYER_H__
@@ -0,0 +1,315 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_layer.c
+ *
+ * @par dependencies
+ * - bsp_led_layer.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's compositing of stacked effect layers of the leds.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-06-20
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_layer.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/**
+ * @brief get the level of a layer which leaves the layers below unchanged.
+ *
+ * @param[in] mode        : Blend mode of the layer.
+ *
+ * @return q15_t : The clear level.
+ *
+ * */
+static q15_t __layer_clear_level(const led_blend_mode_t mode)
+{
+    switch (mode)
+    {
+        case LED_BLEND_REPLACE:
+            return LED_LAYER_CLEAR;
+        case LED_BLEND_MULTIPLY:
+            return LED_LAYER_LEVEL_FULL;
+        case LED_BLEND_ADD:
+        case LED_BLEND_MAX:
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief scale the leds by the levels of a MULTIPLY layer, in place.
+ *
+ * arm_mult_q15() keeps only 1 - 2^-15 of a led under a full level, so a
+ * dimmer at full would darken the leds by one step. The leds under a full
+ * level are left as they are, the rest is scaled in one call if it can.
+ *
+ * @param[in,out] p_out   : The blend so far, scaled in place.
+ * @param[in]     p_level : Levels of the layer.
+ * @param[in]     led_num : Number of leds.
+ *
+ * @return void
+ *
+ * */
+static void __layer_multiply(
+                                  q15_t              *const        p_out,
+                                  q15_t              *const      p_level,
+                            const uint32_t                       led_num
+                            )
+{
+    uint32_t full_num = 0;
+
+    for (uint32_t led = 0; led < led_num; led++)
+    {
+        if ( LED_LAYER_LEVEL_FULL == p_level[led] )
+        {
+            full_num++;
+        }
+    }
+
+    // 1. a dimmer at full, nothing to scale.
+    if ( led_num == full_num )
+    {
+        return;
+    }
+    // 2. no led at full, the whole array in one call.
+    if ( 0 == full_num )
+    {
+        arm_mult_q15(p_out, p_level, p_out, led_num);
+        return;
+    }
+    // 3. some leds at full, scale only the others.
+    for (uint32_t led = 0; led < led_num; led++)
+    {
+        if ( LED_LAYER_LEVEL_FULL != p_level[led] )
+        {
+            arm_mult_q15(&p_out[led], &p_level[led], &p_out[led], 1);
+        }
+    }
+}
+
+led_status_t led_layer_stack_init(
+                                  led_layer_stack_t  *const      p_stack,
+                            const led_blend_mode_t   *const      p_modes,
+                            const uint32_t                     layer_num,
+                            const uint32_t                       led_num
+                                 )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_stack   || NULL == p_modes          ||
+         0    == layer_num || layer_num > LED_LAYER_NUM ||
+         led_num > LED_LAYER_LED_NUM
+       )
+    {
+        DEBUG_OUT("Error: led_layer_stack_init Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    for (uint32_t layer = 0; layer < layer_num; layer++)
+    {
+        if ( p_modes[layer] >= LED_BLEND_NUM )
+        {
+            DEBUG_OUT("Error: The blend mode of a layer is unknown!\r\n");
+            ret = LED_ERRORPARAMETER;
+            return ret;
+        }
+    }
+
+    p_stack->layer_num = layer_num;
+    p_stack->led_num   =   led_num;
+    for (uint32_t led = 0; led < LED_LAYER_LED_NUM; led++)
+    {
+        p_stack->output[led] = 0;
+    }
+    for (uint32_t layer = 0; layer < layer_num; layer++)
+    {
+        p_stack->layers[layer].mode    = p_modes[layer];
+        p_stack->layers[layer].enabled =              1;
+        led_layer_clear(p_stack, layer);
+    }
+
+    return ret;
+}
+
+led_status_t led_layer_level_set(
+                                  led_layer_stack_t  *const      p_stack,
+                            const uint32_t                         layer,
+                            const uint32_t                           led,
+                            const q15_t                            level
+                                )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_stack || layer >= p_stack->layer_num ||
+         led >= p_stack->led_num
+       )
+    {
+        DEBUG_OUT("Error: led_layer_level_set Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    if ( level != p_stack->layers[layer].level[led] )
+    {
+        p_stack->layers[layer].level[led] = level;
+        p_stack->dirty                    =     1;
+    }
+
+    return ret;
+}
+
+led_status_t led_layer_fill(
+                                  led_layer_stack_t  *const      p_stack,
+                            const uint32_t                         layer,
+                            const q15_t                            level
+                           )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_stack || layer >= p_stack->layer_num )
+    {
+        DEBUG_OUT("Error: led_layer_fill Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    for (uint32_t led = 0; led < LED_LAYER_LED_NUM; led++)
+    {
+        p_stack->layers[layer].level[led] = level;
+    }
+    p_stack->dirty = 1;
+
+    return ret;
+}
+
+led_status_t led_layer_clear(
+                                  led_layer_stack_t  *const      p_stack,
+                            const uint32_t                         layer
+                            )
+{
+    if ( NULL == p_stack || layer >= p_stack->layer_num )
+    {
+        DEBUG_OUT("Error: led_layer_clear Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    return led_layer_fill(p_stack, layer,
+                          __layer_clear_level(p_stack->layers[layer].mode));
+}
+
+led_status_t led_layer_enable(
+                                  led_layer_stack_t  *const      p_stack,
+                            const uint32_t                         layer,
+                            const uint32_t                       enabled
+                             )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_stack || layer >= p_stack->layer_num )
+    {
+        DEBUG_OUT("Error: led_layer_enable Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    p_stack->layers[layer].enabled = (0 != enabled) ? 1U : 0;
+    p_stack->dirty                 =                        1;
+
+    return ret;
+}
+
+uint32_t led_layer_compose(
+                                  led_layer_stack_t  *const      p_stack,
+                                  led_duty_t         *const       p_duty
+                          )
+{
+    led_layer_t *p_layer = NULL;
+    q15_t       *p_out   = NULL;
+    uint32_t     led_num = 0;
+
+    if ( NULL == p_stack || NULL == p_duty || 0 == p_stack->dirty )
+    {
+        return 0;
+    }
+    p_stack->dirty = 0;
+    p_out          = p_stack->output;
+    led_num        = p_stack->led_num;
+
+    // 1. the blend starts from black under the bottom layer.
+    for (uint32_t led = 0; led < led_num; led++)
+    {
+        p_out[led] = 0;
+    }
+
+    // 2. blend every enabled layer onto the result, in place.
+    for (uint32_t layer = 0; layer < p_stack->layer_num; layer++)
+    {
+        p_layer = &(p_stack->layers[layer]);
+        if ( 0 == p_layer->enabled )
+        {
+            continue;
+        }
+
+        switch (p_layer->mode)
+        {
+            case LED_BLEND_ADD:
+                arm_add_q15(p_out, p_layer->level, p_out, led_num);
+                break;
+            case LED_BLEND_MULTIPLY:
+                __layer_multiply(p_out, p_layer->level, led_num);
+                break;
+            case LED_BLEND_MAX:
+                for (uint32_t led = 0; led < led_num; led++)
+                {
+                    if ( p_layer->level[led] > p_out[led] )
+                    {
+                        p_out[led] = p_layer->level[led];
+                    }
+                }
+                break;
+            case LED_BLEND_REPLACE:
+            default:
+                for (uint32_t led = 0; led < led_num; led++)
+                {
+                    if ( LED_LAYER_CLEAR != p_layer->level[led] )
+                    {
+                        p_out[led] = p_layer->level[led];
+                    }
+                }
+                break;
+        }
+    }
+
+    // 3. Q15 to the duty, a negative level of ADD or REPLACE is black.
+    for (uint32_t led = 0; led < led_num; led++)
+    {
+        if ( 0 >= p_out[led] )
+        {
+            p_duty[led] = 0;
+        }
+        else
+        {
+            p_duty[led] = (LED_LAYER_LEVEL_FULL == p_out[led]) ?
+                          LED_DUTY_FULL : ((led_duty_t)p_out[led] << 1);
+        }
+    }
+
+    return 1;
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_pattern.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ * - bsp_led_gamma.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's blink pattern bytecode and its interpreter.
+ *
+ * Processing flow:
+ *
+ * led_pattern_start() per command -> led_pattern_tick() per deadline,
+ * called by led_driver_blink_tick() of the blink engine.
+ *
+ * A pattern is a const table of 16-bit ops in flash, the op code is in
+ * the high 4 bits and the argument in the low 12 bits. RAMP and REPEAT
+ * take one more word. Jump targets are word indexes in the table, and
+ * one REPEAT block runs at a time, they are not nested. e.g.
+ *
+ *   "3 fast, pause, 1 long":
+ *   [0] LED_PAT_ON(100),  [1] LED_PAT_OFF(100), [2] LED_PAT_REPEAT(3, 0),
+ *   [4] LED_PAT_OFF(400), [5] LED_PAT_ON(800),  [6] LED_PAT_OFF(400),
+ *   [7] LED_PAT_END()
+ *
+ * @version V1.0 2025-05-24
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_PATTERN_H__
+#define __BSP_LED_PATTERN_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+typedef enum
+{
+    LED_PAT_OP_END        =  0x0,   /* Stop the pattern, the led is off.     */
+    LED_PAT_OP_ON         =  0x1,   /* Led on for arg[ms].                   */
+    LED_PAT_OP_OFF        =  0x2,   /* Led off for arg[ms].                  */
+    LED_PAT_OP_RAMP       =  0x3,   /* Ramp to level of next word in arg[ms].*/
+    LED_PAT_OP_REPEAT     =  0x4,   /* Play from next word arg times in all. */
+    LED_PAT_OP_JUMP       =  0x5,   /* Go on at the op of index arg.         */
+} led_pattern_opcode_t;
+
+/* Max argument of one op                                                   */
+#define LED_PAT_ARG_MAX               (0x0FFFU)
+/* Ops without duration executed per tick at most, it stops a pattern
+   which jumps around without ever waiting                                  */
+#define LED_PATTERN_MAX_STEPS         (16U)
+
+#define LED_PAT_OPCODE(op)            ((uint32_t)(op) >> 12)
+#define LED_PAT_ARG(op)               ((uint32_t)(op) & LED_PAT_ARG_MAX)
+#define LED_PAT_OP(code, arg)                                                 \
+    ((led_pattern_op_t)(((uint32_t)(code) << 12) |                            \
+                        ((uint32_t)(arg) & LED_PAT_ARG_MAX)))
+
+/* Ops to build the const tables of patterns                                */
+#define LED_PAT_ON(ms)                LED_PAT_OP(LED_PAT_OP_ON , ms)
+#define LED_PAT_OFF(ms)               LED_PAT_OP(LED_PAT_OP_OFF, ms)
+#define LED_PAT_RAMP(level, ms)                                               \
+    LED_PAT_OP(LED_PAT_OP_RAMP, ms), (led_pattern_op_t)(level)
+#define LED_PAT_REPEAT(times, to)                                             \
+    LED_PAT_OP(LED_PAT_OP_REPEAT, times), (led_pattern_op_t)(to)
+#define LED_PAT_JUMP(to)              LED_PAT_OP(LED_PAT_OP_JUMP, to)
+#define LED_PAT_END()                 LED_PAT_OP(LED_PAT_OP_END , 0)
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* 3 short blinks, a pause and 1 long blink                                 */
+extern const led_pattern_op_t led_pattern_3_short_1_long[];
+/* Breathing along the brightness table without end                         */
+extern const led_pattern_op_t led_pattern_breathe[];
+
+/**
+ * @brief load the pattern into the blink engine of the target and run its
+ *        first ops.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] p_pattern   : The pattern in flash, ended by LED_PAT_END.
+ * @param[in] now_us      : Current time base[us].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_pattern_start(
+                                  bsp_led_driver_t   *const      self,
+                            const led_pattern_op_t   *const p_pattern,
+                            const uint32_t                     now_us
+                              );
+
+/**
+ * @brief run the ops of the pattern whose deadline has expired.
+ *
+ * The deadlines add up from the start, so the pattern does not drift
+ * even if the tick is late.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] now_us      : Current time base[us].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_pattern_tick(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us
+                             );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_PATTERN_H__
@@ -0,0 +1,277 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_pattern.c
+ *
+ * @par dependencies
+ * - bsp_led_pattern.h
+ * - bsp_led_gamma.h
+ * - bsp_led_wave.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's blink pattern bytecode and its interpreter.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-05-24
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_pattern.h"
+#include "bsp_led_gamma.h"
+#include "bsp_led_wave.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Level[Q16] of the full brightness                                        */
+#define __PATTERN_LEVEL_FULL          ((int32_t)LED_GAMMA_LEVEL_MAX << 16)
+
+const led_pattern_op_t led_pattern_3_short_1_long[] =
+{
+    /* 0 */ LED_PAT_ON(100)      ,
+    /* 1 */ LED_PAT_OFF(100)     ,
+    /* 2 */ LED_PAT_REPEAT(3, 0) ,
+    /* 4 */ LED_PAT_OFF(400)     ,
+    /* 5 */ LED_PAT_ON(800)      ,
+    /* 6 */ LED_PAT_OFF(400)     ,
+    /* 7 */ LED_PAT_END()        ,
+};
+
+const led_pattern_op_t led_pattern_breathe[] =
+{
+    /* 0 */ LED_PAT_RAMP(LED_GAMMA_LEVEL_MAX, 1500),
+    /* 2 */ LED_PAT_RAMP(0                  , 1500),
+    /* 4 */ LED_PAT_OFF(500)                      ,
+    /* 5 */ LED_PAT_JUMP(0)                       ,
+};
+
+/**
+ * @brief stop the pattern and leave the led off.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+static led_status_t __pattern_stop(bsp_led_driver_t *const self)
+{
+    self->blink_state.phase         = LED_PHASE_IDLE;
+    self->blink_state.pattern_level =              0;
+    self->blink_state.output_duty   =              0;
+
+    return self->p_led_opes->pf_led_off();
+}
+
+/**
+ * @brief write the level[Q16] of the pattern to the led.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] level       : Level[Q16 of 0..255] to be shown.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+static led_status_t __pattern_level_write(
+                            bsp_led_driver_t *const   self,
+                      const int32_t                  level
+                                         )
+{
+    self->blink_state.pattern_level = level;
+
+    return led_driver_level_write(self,
+                                  led_gamma_cie1931[(uint32_t)level >> 16]);
+}
+
+/**
+ * @brief write one frame of the ramp in progress.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] now_us      : Current time base[us], before the ramp ends.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+static led_status_t __pattern_ramp_frame(
+                            bsp_led_driver_t *const   self,
+                      const uint32_t                now_us
+                                        )
+{
+    led_blink_state_t *p_state = &(self->blink_state);
+    // the step is per ms, one division per frame, not per microsecond.
+    int32_t            level   = p_state->ramp_from +
+                                 (int32_t)((now_us - p_state->wave_start_us) /
+                                           LED_US_PER_MS) * p_state->ramp_step;
+
+    p_state->next_edge_us = now_us + LED_WAVE_FRAME_MS * LED_US_PER_MS;
+    if ( !LED_TIME_BEFORE(p_state->next_edge_us, p_state->wave_end_us) )
+    {
+        p_state->next_edge_us = p_state->wave_end_us;
+    }
+
+    return __pattern_level_write(self, level);
+}
+
+led_status_t led_pattern_start(
+                                  bsp_led_driver_t   *const      self,
+                            const led_pattern_op_t   *const p_pattern,
+                            const uint32_t                     now_us
+                              )
+{
+    led_status_t       ret     = LED_OK;
+    led_blink_state_t *p_state = NULL;
+
+    if ( NULL == self || LED_NOT_INITED == self->is_inited )
+    {
+        DEBUG_OUT("Error: The driver has not been initialized!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    if ( NULL == p_pattern )
+    {
+        DEBUG_OUT("Error: led_pattern_start Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    // a ramp needs a flicker free period on a duty-cycle backend.
+    ret = led_driver_dim_period_set(self);
+    if (LED_OK != ret)
+    {
+        return ret;
+    }
+
+    p_state                 = &(self->blink_state);
+    p_state->p_pattern      =         p_pattern;
+    p_state->pattern_pc     =                 0;
+    p_state->pattern_repeat =                 0;
+    p_state->pattern_level  =                 0;
+    p_state->phase          = LED_PHASE_PATTERN;
+    p_state->next_edge_us   =            now_us;
+
+    return led_pattern_tick(self, now_us);
+}
+
+led_status_t led_pattern_tick(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us
+                             )
+{
+    led_status_t       ret      = LED_OK;
+    led_blink_state_t *p_state  = &(self->blink_state);
+    led_pattern_op_t   op       = 0;
+    uint32_t           arg      = 0;
+    uint32_t           steps    = 0;
+    uint32_t           edge_us  = 0;
+    int32_t            level_to = 0;
+
+    while ( ( LED_PHASE_PATTERN == p_state->phase   ||
+              LED_PHASE_RAMP    == p_state->phase )    &&
+            !LED_TIME_BEFORE(now_us, p_state->next_edge_us)
+          )
+    {
+        // 1. a ramp in progress writes one frame per deadline.
+        if ( LED_PHASE_RAMP == p_state->phase )
+        {
+            if ( LED_TIME_BEFORE(now_us, p_state->wave_end_us) )
+            {
+                return __pattern_ramp_frame(self, now_us);
+            }
+
+            // 1-1. the ramp is over, go on at its end, not at now_us.
+            p_state->phase        =      LED_PHASE_PATTERN;
+            p_state->next_edge_us =   p_state->wave_end_us;
+            ret = __pattern_level_write(self, p_state->ramp_to);
+            continue;
+        }
+
+        // 2. fetch the next op.
+        op      = p_state->p_pattern[p_state->pattern_pc];
+        arg     = LED_PAT_ARG(op);
+        edge_us = p_state->next_edge_us;
+
+        switch ( LED_PAT_OPCODE(op) )
+        {
+            case LED_PAT_OP_ON:
+                ret = self->p_led_opes->pf_led_on();
+                p_state->output_duty    =        LED_DUTY_FULL;
+                p_state->pattern_level  = __PATTERN_LEVEL_FULL;
+                p_state->next_edge_us  +=  arg * LED_US_PER_MS;
+                p_state->pattern_pc    +=                    1;
+                break;
+            case LED_PAT_OP_OFF:
+                ret = self->p_led_opes->pf_led_off();
+                p_state->output_duty    =                    0;
+                p_state->pattern_level  =                    0;
+                p_state->next_edge_us  +=  arg * LED_US_PER_MS;
+                p_state->pattern_pc    +=                    1;
+                break;
+            case LED_PAT_OP_RAMP:
+                level_to = (int32_t)(p_state->p_pattern[
+                                     p_state->pattern_pc + 1] & 0xFFU) << 16;
+                p_state->pattern_pc    +=                    2;
+                if ( 0 == arg )
+                {
+                    ret = __pattern_level_write(self, level_to);
+                    break;
+                }
+                // the only division of a ramp, once per op.
+                p_state->ramp_from      = p_state->pattern_level;
+                p_state->ramp_to        =               level_to;
+                p_state->ramp_step      = (level_to - p_state->ramp_from) /
+                                                          (int32_t)arg;
+                p_state->wave_start_us  =                  edge_us;
+                p_state->wave_end_us    = edge_us + arg * LED_US_PER_MS;
+                p_state->phase          =           LED_PHASE_RAMP;
+                break;
+            case LED_PAT_OP_REPEAT:
+                // the block has been played once when the op is reached.
+                if ( 0 == p_state->pattern_repeat )
+                {
+                    p_state->pattern_repeat = (uint16_t)arg;
+                }
+                if ( 1 < p_state->pattern_repeat )
+                {
+                    p_state->pattern_repeat--;
+                    p_state->pattern_pc = p_state->p_pattern[
+                                                    p_state->pattern_pc + 1];
+                }
+                else
+                {
+                    p_state->pattern_repeat  = 0;
+                    p_state->pattern_pc     += 2;
+                }
+                break;
+            case LED_PAT_OP_JUMP:
+                p_state->pattern_pc = (uint16_t)arg;
+                break;
+            case LED_PAT_OP_END:
+            default:
+                return __pattern_stop(self);
+        }
+
+        // 3. the ops without duration are limited per tick.
+        if ( edge_us == p_state->next_edge_us      &&
+             LED_PHASE_RAMP != p_state->phase      &&
+             LED_PATTERN_MAX_STEPS <= ++ steps
+           )
+        {
+            DEBUG_OUT("Error: The pattern never waits, it is stopped!\r\n");
+            __pattern_stop(self);
+            ret = LED_ERROR;
+            return ret;
+        }
+    }
+
+    return ret;
+}
+//******************************** Defines **********************************//
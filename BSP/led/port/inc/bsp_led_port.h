@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_port.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's write-coalescing shadow of the GPIO ports of leds.
+ *
+ * Processing flow:
+ *
+ * led_port_init() per port -> led_port_pin_write() per led output
+ *                          -> led_port_flush() once per engine tick.
+ *
+ * A write only changes the requested level in RAM, the flush stores the
+ * pins which differ from the shadow with one BSRR word per port, so the
+ * leds of a port changed in one tick cost one bus write and a level
+ * written twice costs none. The caller serializes the writes and the
+ * flush of one port, e.g. in a critical section of the system layer.
+ *
+ * @version V1.0 2025-05-26
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_PORT_H__
+#define __BSP_LED_PORT_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Pins of one port                                                         */
+#define LED_PORT_PIN_MASK             (0xFFFFU)
+/* Bit offset of the reset bits in BSRR                                     */
+#define LED_PORT_BSRR_RESET_SHIFT     (16U)
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* BSRR register of the port                       */
+    volatile uint32_t                           *p_bsrr;
+    /* Level of the pins stored by the last flush      */
+    uint32_t                                     shadow;
+    /* Level of the pins requested since the flush     */
+    uint32_t                                    request;
+} led_port_t;
+
+/**
+ * @brief init the shadow of a port with the level of its pins.
+ *
+ * @param[out] p_port      : The shadow of the port.
+ * @param[in]  p_bsrr      : BSRR register of the port.
+ * @param[in]  level       : Current level of the pins, e.g. read from ODR.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_port_init(
+                                  led_port_t         *const       p_port,
+                                  volatile uint32_t  *const       p_bsrr,
+                            const uint32_t                         level
+                          );
+
+/**
+ * @brief request the level of pins, nothing is stored to the port.
+ *
+ * @param[in] p_port      : The shadow of the port.
+ * @param[in] pin_mask    : Pins to be written.
+ * @param[in] is_high     : Non-zero to set the pins, zero to reset them.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_port_pin_write(
+                                  led_port_t         *const       p_port,
+                            const uint32_t                      pin_mask,
+                            const uint32_t                       is_high
+                               );
+
+/**
+ * @brief store the requested level of every port whose pins have changed,
+ *        one BSRR word per port.
+ *
+ * @param[in] p_ports     : The shadows of the ports.
+ * @param[in] port_num    : Number of the ports.
+ *
+ * @return uint32_t : Number of the BSRR words stored.
+ *
+ * */
+uint32_t led_port_flush(
+                                  led_port_t         *const      p_ports,
+                            const uint32_t                      port_num
+                       );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_PORT_H__
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_port.c
+ *
+ * @par dependencies
+ * - bsp_led_port.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's write-coalescing shadow of the GPIO ports of leds.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-05-26
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_port.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+/**
+ * @brief init the shadow of a port with the level of its pins.
+ *
+ * @param[out] p_port      : The shadow of the port.
+ * @param[in]  p_bsrr      : BSRR register of the port.
+ * @param[in]  level       : Current level of the pins, e.g. read from ODR.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_port_init(
+                                  led_port_t         *const       p_port,
+                                  volatile uint32_t  *const       p_bsrr,
+                            const uint32_t                         level
+                          )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_port || NULL == p_bsrr )
+    {
+        DEBUG_OUT("Error: led_port_init Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    p_port->p_bsrr  =                          p_bsrr;
+    p_port->shadow  =       level & LED_PORT_PIN_MASK;
+    p_port->request =                  p_port->shadow;
+
+    return ret;
+}
+
+/**
+ * @brief request the level of pins, nothing is stored to the port.
+ *
+ * @param[in] p_port      : The shadow of the port.
+ * @param[in] pin_mask    : Pins to be written.
+ * @param[in] is_high     : Non-zero to set the pins, zero to reset them.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_port_pin_write(
+                                  led_port_t         *const       p_port,
+                            const uint32_t                      pin_mask,
+                            const uint32_t                       is_high
+                               )
+{
+    if ( 0 != is_high )
+    {
+        p_port->request |=  (pin_mask & LED_PORT_PIN_MASK);
+    }
+    else
+    {
+        p_port->request &= ~(pin_mask & LED_PORT_PIN_MASK);
+    }
+
+    return LED_OK;
+}
+
+/**
+ * @brief store the requested level of every port whose pins have changed,
+ *        one BSRR word per port.
+ *
+ * @param[in] p_ports     : The shadows of the ports.
+ * @param[in] port_num    : Number of the ports.
+ *
+ * @return uint32_t : Number of the BSRR words stored.
+ *
+ * */
+uint32_t led_port_flush(
+                                  led_port_t         *const      p_ports,
+                            const uint32_t                      port_num
+                       )
+{
+    uint32_t stores  = 0;
+    uint32_t changed = 0;
+
+    for (uint32_t port = 0; port < port_num; port++)
+    {
+        // a pin written back to its old level in the tick is no change.
+        changed = p_ports[port].request ^ p_ports[port].shadow;
+        if ( 0 == changed )
+        {
+            continue;
+        }
+
+        *(p_ports[port].p_bsrr) = ( changed &  p_ports[port].request) |
+                                  ((changed & ~p_ports[port].request) <<
+                                               LED_PORT_BSRR_RESET_SHIFT);
+        p_ports[port].shadow    =               p_ports[port].request;
+        stores++;
+    }
+
+    return stores;
+}
+//******************************** Defines **********************************//
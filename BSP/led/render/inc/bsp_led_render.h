@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_render.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ * - bsp_led_handler.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's renderer of blink sequences into GPIO BSRR words.
+ *
+ * Processing flow:
+ *
+ * led_render_track_init() per led -> led_render_bsrr() per buffer chunk.
+ *
+ * Every sample is one BSRR word of a port, a timer triggered DMA writes
+ * one sample per period, so the renderer has no hardware dependency.
+ *
+ * @version V1.0 2025-05-12
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_RENDER_H__
+#define __BSP_LED_RENDER_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include "bsp_led_handler.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Period[us] of one sample, same as the trigger of the DMA                 */
+#define LED_RENDER_SAMPLE_US          (10U)
+/* Max number of leds rendered into one port                                */
+#define LED_RENDER_TRACK_NUM          (16U)
+/* Bit offset of the reset bits in BSRR                                     */
+#define LED_RENDER_BSRR_RESET_SHIFT   (16U)
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* Pin mask of the led in the port, 0 if unused    */
+    uint16_t                                   pin_mask;
+    /* Samples of the on time in one cycle             */
+    uint32_t                                 on_samples;
+    /* Samples of one cycle                            */
+    uint32_t                              cycle_samples;
+    /* Samples of the whole sequence                   */
+    uint32_t                              total_samples;
+    /* Sample index at which the sequence starts       */
+    uint32_t                               start_sample;
+    /* Non-zero if the led is on at the low level      */
+    uint32_t                              is_active_low;
+} led_render_track_t;
+
+/**
+ * @brief convert the parameters of an event into a track of the port.
+ * 
+ * @param[out] p_track      : The track to be filled.
+ * @param[in]  p_event      : The event which describes the blink.
+ * @param[in]  pin_mask     : Pin mask of the led in the port.
+ * @param[in]  start_sample : Sample index at which the sequence starts.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_render_track_init(
+                                  led_render_track_t *const      p_track,
+                            const led_event_t        *const      p_event,
+                            const uint16_t                      pin_mask,
+                            const uint32_t                  start_sample
+                                  );
+
+/**
+ * @brief render the samples [first_sample, first_sample + sample_num) of
+ *        all tracks into BSRR words.
+ * 
+ * Each active track sets its pin in the on time and resets it in the off
+ * time, a track writes nothing before its start so other owners of the 
+ * port are not disturbed, and keeps resetting its pin after the end. The
+ * levels are swapped for an active low led.
+ *  
+ * @param[in]  p_tracks     : The tracks of one port.
+ * @param[in]  track_num    : Number of tracks.
+ * @param[in]  first_sample : Sample index of p_buffer[0].
+ * @param[out] p_buffer     : The BSRR words.
+ * @param[in]  sample_num   : Number of samples to render.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_render_bsrr(
+                            const led_render_track_t *const     p_tracks,
+                            const uint32_t                     track_num,
+                            const uint32_t                  first_sample,
+                                  uint32_t           *const     p_buffer,
+                            const uint32_t                    sample_num
+                            );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_RENDER_H__
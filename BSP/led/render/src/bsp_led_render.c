@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_render.c
+ *
+ * @par dependencies
+ * - bsp_led_render.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's renderer of blink sequences into GPIO BSRR words.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-05-12
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_render.h"
+#include <string.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+/**
+ * @brief convert the parameters of an event into a track of the port.
+ * 
+ * @param[out] p_track      : The track to be filled.
+ * @param[in]  p_event      : The event which describes the blink.
+ * @param[in]  pin_mask     : Pin mask of the led in the port.
+ * @param[in]  start_sample : Sample index at which the sequence starts.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_render_track_init(
+                                  led_render_track_t *const      p_track,
+                            const led_event_t        *const      p_event,
+                            const uint16_t                      pin_mask,
+                            const uint32_t                  start_sample
+                                  )
+{
+    led_status_t ret           = LED_OK;
+    uint32_t     on_samples    =      0;
+    uint32_t     cycle_samples =      0;
+
+    // a cycle is a whole number of samples, sub-sample cycles are refused.
+    if ( NULL == p_track || NULL == p_event || 0 == pin_mask  ||
+         0    == p_event->cycle_time_us     || 0 == p_event->blink_times ||
+         0    != p_event->cycle_time_us % LED_RENDER_SAMPLE_US           ||
+         LED_WAVE_SQUARE != p_event->shape
+       )
+    {
+        DEBUG_OUT("Error: led_render_track_init Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    cycle_samples = p_event->cycle_time_us / LED_RENDER_SAMPLE_US;
+    ret = led_driver_on_time_calc(cycle_samples,
+                                  p_event->duty,
+                                  &on_samples);
+    if ( LED_OK != ret )
+    {
+        return ret;
+    }
+
+    p_track->pin_mask      =                                      pin_mask;
+    p_track->on_samples    =                                    on_samples;
+    p_track->cycle_samples =                                 cycle_samples;
+    p_track->total_samples = p_track->cycle_samples * p_event->blink_times;
+    p_track->start_sample  =                                  start_sample;
+    p_track->is_active_low =                                             0;
+
+    return ret;
+}
+
+/**
+ * @brief render the samples [first_sample, first_sample + sample_num) of
+ *        all tracks into BSRR words.
+ * 
+ * Each active track sets its pin in the on time and resets it in the off
+ * time, a track writes nothing before its start so other owners of the 
+ * port are not disturbed, and keeps resetting its pin after the end. The
+ * levels are swapped for an active low led.
+ *  
+ * @param[in]  p_tracks     : The tracks of one port.
+ * @param[in]  track_num    : Number of tracks.
+ * @param[in]  first_sample : Sample index of p_buffer[0].
+ * @param[out] p_buffer     : The BSRR words.
+ * @param[in]  sample_num   : Number of samples to render.
+ * 
+ * @return led_status_t : Status of the function.
+ * 
+ * */
+led_status_t led_render_bsrr(
+                            const led_render_track_t *const     p_tracks,
+                            const uint32_t                     track_num,
+                            const uint32_t                  first_sample,
+                                  uint32_t           *const     p_buffer,
+                            const uint32_t                    sample_num
+                            )
+{
+    led_status_t              ret     = LED_OK;
+    const led_render_track_t *p_track = NULL;
+
+    if ( NULL == p_tracks || NULL == p_buffer     ||
+         track_num > LED_RENDER_TRACK_NUM
+       )
+    {
+        DEBUG_OUT("Error: led_render_bsrr Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    memset(p_buffer, 0, sample_num * sizeof(uint32_t));
+
+    for ( uint32_t track_number = 0; track_number < track_num; ++ track_number)
+    {
+        p_track = &(p_tracks[track_number]);
+        if ( 0 == p_track->pin_mask || 0 == p_track->cycle_samples )
+        {
+            continue;
+        }
+
+        uint32_t set_word   = (uint32_t)p_track->pin_mask;
+        uint32_t reset_word = (uint32_t)p_track->pin_mask 
+                                            << LED_RENDER_BSRR_RESET_SHIFT;
+        if ( 0 != p_track->is_active_low )
+        {
+            set_word   =                    reset_word;
+            reset_word = (uint32_t)p_track->pin_mask;
+        }
+        // 1. the position in the sequence and in the cycle of p_buffer[0],
+        //    the only division of the track in this chunk.
+        int32_t  position   = (int32_t)(first_sample - p_track->start_sample);
+        uint32_t in_cycle   = 0;
+        if ( position > 0 )
+        {
+            in_cycle = (uint32_t)position % p_track->cycle_samples;
+        }
+
+        // 2. walk the samples with running counters.
+        for ( uint32_t sample = 0; sample < sample_num; ++ sample)
+        {
+            if ( position >= 0 )
+            {
+                if ( (uint32_t)position >= p_track->total_samples )
+                {
+                    p_buffer[sample] |=   reset_word;
+                }
+                else if ( in_cycle < p_track->on_samples )
+                {
+                    p_buffer[sample] |=     set_word;
+                }
+                else
+                {
+                    p_buffer[sample] |=   reset_word;
+                }
+
+                if ( ++ in_cycle >= p_track->cycle_samples )
+                {
+                    in_cycle = 0;
+                }
+            }
+            position++;
+        }
+    }
+
+    return ret;
+}
+//******************************** Defines **********************************//
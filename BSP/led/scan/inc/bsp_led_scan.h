@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_scan.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's row scan of a led matrix or a charlieplexed set.
+ *
+ * Processing flow:
+ *
+ * led_scan_init() -> led_scan_cell_write() per led output
+ *                 -> led_scan_commit() once per engine tick
+ *                 -> led_scan_isr() per timer interrupt, one row each.
+ *
+ * The framebuffer holds one bit per cell, bit col of cells[row]. The
+ * commit turns every row into three register words, so the ISR costs 
+ * three stores whatever the number of columns:
+ *
+ *   step        matrix                    charlieplex
+ *   blank       row BSRR, no row active   MODER, every pin an input
+ *   data        col BSRR, lit columns     BSRR, anode high, others low
+ *   select      row BSRR, the row active  MODER, anode and lit cathodes
+ *                                         as outputs
+ *
+ * In a charlieplexed set of N pins on one port, row r is the anode pin r
+ * and column c the cathode pin c, the cells of the diagonal are unused,
+ * so N pins drive N * (N - 1) leds. The steps are double buffered, the 
+ * ISR takes the new ones at row 0, so a frame never mixes two commits.
+ *
+ * @version V1.0 2025-06-02
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_SCAN_H__
+#define __BSP_LED_SCAN_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Rows of one engine, or pins of a charlieplexed set                       */
+#ifndef LED_SCAN_ROW_MAX
+#define LED_SCAN_ROW_MAX              (16U)
+#endif
+/* Columns of one engine, the pins of one port                              */
+#define LED_SCAN_COL_MAX              (16U)
+/* Cell index of a led                                                      */
+#define LED_SCAN_CELL(row, col, col_num)  ((row) * (col_num) + (col))
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef enum
+{
+    LED_SCAN_MATRIX       =    0,   /* Rows and columns of pins.             */
+    LED_SCAN_CHARLIEPLEX  =    1,   /* Pin pairs of one port.                */
+} led_scan_type_t;
+
+typedef struct
+{
+    led_scan_type_t                                type;
+    /* Rows, or pins of a charlieplexed set            */
+    uint32_t                                    row_num;
+    /* Columns, equal to row_num for a charlieplex     */
+    uint32_t                                    col_num;
+    /* Pin of every row, GPIO_PIN_x                    */
+    const uint16_t                          *p_row_pins;
+    /* Pin of every column, unused for a charlieplex   */
+    const uint16_t                          *p_col_pins;
+    /* Non-zero if a row is selected at low level      */
+    uint8_t                              row_active_low;
+    /* Non-zero if a column is lit at low level        */
+    uint8_t                              col_active_low;
+    /* BSRR of the rows, or of the charlieplexed port  */
+    volatile uint32_t                       *p_row_bsrr;
+    /* BSRR of the columns, unused for a charlieplex   */
+    volatile uint32_t                       *p_col_bsrr;
+    /* MODER of the charlieplexed port                 */
+    volatile uint32_t                          *p_moder;
+    /* Dwell[us] of every row after init               */
+    uint32_t                                   dwell_us;
+} led_scan_config_t;
+
+typedef struct
+{
+    /* Word stored to blank the last row               */
+    uint32_t                                      blank;
+    /* Word stored for the cells of the row            */
+    uint32_t                                       data;
+    /* Word stored to light the row                    */
+    uint32_t                                     select;
+} led_scan_step_t;
+
+typedef struct
+{
+    /* Registers of the blank, data and select words   */
+    volatile uint32_t                       *p_blank_reg;
+    volatile uint32_t                        *p_data_reg;
+    volatile uint32_t                      *p_select_reg;
+    /* The wiring, kept by the engine                  */
+    const led_scan_config_t                   *p_config;
+    /* MODER with every charlieplexed pin an input     */
+    uint32_t                                 moder_base;
+    /* Framebuffer, bit col of cells[row]              */
+    uint32_t                     cells[LED_SCAN_ROW_MAX];
+    /* Dwell[us] of every row                          */
+    uint32_t                  dwell_us[LED_SCAN_ROW_MAX];
+    /* Non-zero if a cell changed since the commit     */
+    uint32_t                                      dirty;
+    /* Two frames of steps                             */
+    led_scan_step_t            steps[2][LED_SCAN_ROW_MAX];
+    /* Frame shown by the ISR                          */
+    volatile uint32_t                             front;
+    /* Non-zero if the other frame is to be shown      */
+    volatile uint32_t                      swap_request;
+    /* Row shown by the next interrupt                 */
+    uint32_t                                        row;
+} led_scan_t;
+
+/**
+ * @brief init the engine from its wiring, every led is off.
+ *
+ * @param[out] p_scan      : The engine.
+ * @param[in]  p_config    : The wiring, kept by the engine.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_scan_init(
+                                  led_scan_t         *const       p_scan,
+                            const led_scan_config_t  *const     p_config
+                          );
+
+/**
+ * @brief request the level of a cell, nothing is shown before the commit.
+ *
+ * @param[in] p_scan      : The engine.
+ * @param[in] cell        : Index of the cell, LED_SCAN_CELL(row, col, n).
+ * @param[in] is_on       : Non-zero to light the led.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_scan_cell_write(
+                                  led_scan_t         *const       p_scan,
+                            const uint32_t                          cell,
+                            const uint32_t                         is_on
+                                );
+
+/**
+ * @brief set the dwell of the rows, the refresh rate is 1 / the sum.
+ *
+ * @param[in] p_scan      : The engine.
+ * @param[in] row         : Index of the row, or row_num for every row.
+ * @param[in] dwell_us    : Dwell[us] of the row, not 0.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_scan_dwell_set(
+                                  led_scan_t         *const       p_scan,
+                            const uint32_t                           row,
+                            const uint32_t                      dwell_us
+                               );
+
+/**
+ * @brief build the steps of the framebuffer and hand them to the ISR,
+ *        nothing is done if no cell changed.
+ *
+ * @param[in] p_scan      : The engine.
+ *
+ * @return uint32_t : 1 if new steps are handed to the ISR, else 0.
+ *
+ * */
+uint32_t led_scan_commit(led_scan_t *const p_scan);
+
+/**
+ * @brief blank the last row and light the next one, called by the timer
+ *        interrupt.
+ *
+ * @param[in] p_scan      : The engine.
+ *
+ * @return uint32_t : Dwell[us] of the row lit, the time until the next 
+ *                    interrupt.
+ *
+ * */
+uint32_t led_scan_isr(led_scan_t *const p_scan);
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_SCAN_H__
@@ -0,0 +1,342 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_scan.c
+ *
+ * @par dependencies
+ * - bsp_led_scan.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's row scan of a led matrix or a charlieplexed set.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-06-02
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_scan.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Bit offset of the reset bits in BSRR                                     */
+#define __SCAN_BSRR_RESET_SHIFT       (16U)
+/* Mode bits of one pin in MODER, 00 input and 01 output                    */
+#define __SCAN_MODER_MASK             (3U)
+#define __SCAN_MODER_OUTPUT           (1U)
+
+/**
+ * @brief get the BSRR word which drives the pins to a level.
+ *
+ * @param[in] pin_mask    : The pins.
+ * @param[in] is_high     : Non-zero to set the pins, zero to reset them.
+ *
+ * @return uint32_t : The BSRR word.
+ *
+ * */
+static uint32_t __scan_bsrr(const uint32_t pin_mask, const uint32_t is_high)
+{
+    return (0 != is_high) ? pin_mask : (pin_mask << __SCAN_BSRR_RESET_SHIFT);
+}
+
+/**
+ * @brief get the MODER bits which make one pin an output.
+ *
+ * @param[in] pin_mask    : The pin, GPIO_PIN_x.
+ *
+ * @return uint32_t : The MODER bits.
+ *
+ * */
+static uint32_t __scan_moder_output(const uint32_t pin_mask)
+{
+    uint32_t pin = 0;
+
+    while ( (1U << pin) < pin_mask )
+    {
+        pin++;
+    }
+
+    return __SCAN_MODER_OUTPUT << (pin * 2U);
+}
+
+/**
+ * @brief build the steps of one row of a matrix.
+ *
+ * @param[in]  p_scan      : The engine.
+ * @param[in]  row         : Index of the row.
+ * @param[out] p_step      : The steps of the row.
+ *
+ * */
+static void __scan_matrix_row(
+                            const led_scan_t         *const       p_scan,
+                            const uint32_t                           row,
+                                  led_scan_step_t    *const       p_step
+                             )
+{
+    const led_scan_config_t *p_config = p_scan->p_config;
+    uint32_t                 lit      = 0;
+
+    p_step->blank  = 0;
+    p_step->data   = 0;
+    p_step->select = 0;
+
+    for (uint32_t col = 0; col < p_config->col_num; col++)
+    {
+        lit = (p_scan->cells[row] >> col) & 1U;
+        p_step->data |= __scan_bsrr(p_config->p_col_pins[col],
+                                    lit ^ p_config->col_active_low);
+    }
+
+    for (uint32_t other = 0; other < p_config->row_num; other++)
+    {
+        p_step->blank  |= __scan_bsrr(p_config->p_row_pins[other],
+                                      p_config->row_active_low);
+        p_step->select |= __scan_bsrr(p_config->p_row_pins[other],
+                                      (other == row) ^ 
+                                      p_config->row_active_low);
+    }
+}
+
+/**
+ * @brief build the steps of one anode of a charlieplexed set.
+ *
+ * @param[in]  p_scan      : The engine.
+ * @param[in]  row         : Index of the anode pin.
+ * @param[out] p_step      : The steps of the anode.
+ *
+ * */
+static void __scan_charlieplex_row(
+                            const led_scan_t         *const       p_scan,
+                            const uint32_t                           row,
+                                  led_scan_step_t    *const       p_step
+                                  )
+{
+    const led_scan_config_t *p_config = p_scan->p_config;
+    uint32_t                 anode    = p_config->p_row_pins[row];
+    uint32_t                 others   = 0;
+
+    p_step->blank  = p_scan->moder_base;
+    p_step->select = p_scan->moder_base | __scan_moder_output(anode);
+
+    for (uint32_t col = 0; col < p_config->col_num; col++)
+    {
+        if ( col == row )
+        {
+            continue;
+        }
+        others |= p_config->p_row_pins[col];
+        // an unlit cathode stays an input, no current flows through it.
+        if ( 0 != ((p_scan->cells[row] >> col) & 1U) )
+        {
+            p_step->select |= 
+                        __scan_moder_output(p_config->p_row_pins[col]);
+        }
+    }
+
+    p_step->data = __scan_bsrr(anode, 1) | __scan_bsrr(others, 0);
+}
+
+led_status_t led_scan_init(
+                                  led_scan_t         *const       p_scan,
+                            const led_scan_config_t  *const     p_config
+                          )
+{
+    led_status_t ret        = LED_OK;
+    uint32_t     moder_mask = 0;
+
+    if ( NULL == p_scan || NULL == p_config || NULL == p_config->p_row_pins ||
+         NULL == p_config->p_row_bsrr                                       ||
+         0    == p_config->dwell_us                                         ||
+         0    == p_config->row_num  || LED_SCAN_ROW_MAX < p_config->row_num ||
+         0    == p_config->col_num  || LED_SCAN_COL_MAX < p_config->col_num
+       )
+    {
+        DEBUG_OUT("Error: led_scan_init Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    p_scan->p_config = p_config;
+
+    // 1. the registers of the steps depend on the wiring.
+    if ( LED_SCAN_CHARLIEPLEX == p_config->type )
+    {
+        if ( NULL == p_config->p_moder                ||
+             p_config->row_num != p_config->col_num
+           )
+        {
+            DEBUG_OUT("Error: The charlieplex wiring is invalid!\r\n");
+            ret = LED_ERRORPARAMETER;
+            return ret;
+        }
+        for (uint32_t pin = 0; pin < p_config->row_num; pin++)
+        {
+            moder_mask |= __scan_moder_output(p_config->p_row_pins[pin]) *
+                                                        __SCAN_MODER_MASK;
+        }
+        // the other pins of the port keep the mode they have now.
+        p_scan->moder_base   = *(p_config->p_moder) & ~moder_mask;
+        p_scan->p_blank_reg  =      p_config->p_moder;
+        p_scan->p_data_reg   =   p_config->p_row_bsrr;
+        p_scan->p_select_reg =      p_config->p_moder;
+    }
+    else
+    {
+        if ( NULL == p_config->p_col_pins || NULL == p_config->p_col_bsrr )
+        {
+            DEBUG_OUT("Error: The matrix wiring is invalid!\r\n");
+            ret = LED_ERRORPARAMETER;
+            return ret;
+        }
+        p_scan->moder_base   =                      0;
+        p_scan->p_blank_reg  =   p_config->p_row_bsrr;
+        p_scan->p_data_reg   =   p_config->p_col_bsrr;
+        p_scan->p_select_reg =   p_config->p_row_bsrr;
+    }
+
+    for (uint32_t row = 0; row < LED_SCAN_ROW_MAX; row++)
+    {
+        p_scan->cells[row]    =                  0;
+        p_scan->dwell_us[row] = p_config->dwell_us;
+    }
+    p_scan->front        = 0;
+    p_scan->swap_request = 0;
+    p_scan->row          = 0;
+    p_scan->dirty        = 1;
+
+    // 2. both frames are dark, the ISR may start at once.
+    led_scan_commit(p_scan);
+    for (uint32_t row = 0; row < p_config->row_num; row++)
+    {
+        p_scan->steps[0][row] = p_scan->steps[1][row];
+    }
+
+    return ret;
+}
+
+led_status_t led_scan_cell_write(
+                                  led_scan_t         *const       p_scan,
+                            const uint32_t                          cell,
+                            const uint32_t                         is_on
+                                )
+{
+    led_status_t ret = LED_OK;
+    uint32_t     row = 0;
+    uint32_t     col = 0;
+
+    if ( NULL == p_scan ||
+         cell >= p_scan->p_config->row_num * p_scan->p_config->col_num
+       )
+    {
+        DEBUG_OUT("Error: led_scan_cell_write Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    row = cell / p_scan->p_config->col_num;
+    col = cell % p_scan->p_config->col_num;
+    if ( LED_SCAN_CHARLIEPLEX == p_scan->p_config->type && row == col )
+    {
+        DEBUG_OUT("Error: The charlieplex has no led on a diagonal!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    if ( ((p_scan->cells[row] >> col) & 1U) != (0 != is_on) )
+    {
+        p_scan->cells[row] ^= 1U << col;
+        p_scan->dirty       =         1;
+    }
+
+    return ret;
+}
+
+led_status_t led_scan_dwell_set(
+                                  led_scan_t         *const       p_scan,
+                            const uint32_t                           row,
+                            const uint32_t                      dwell_us
+                               )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_scan || 0 == dwell_us || row > p_scan->p_config->row_num )
+    {
+        DEBUG_OUT("Error: led_scan_dwell_set Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    for (uint32_t index = 0; index < p_scan->p_config->row_num; index++)
+    {
+        if ( row == index || row == p_scan->p_config->row_num )
+        {
+            p_scan->dwell_us[index] = dwell_us;
+        }
+    }
+
+    return ret;
+}
+
+uint32_t led_scan_commit(led_scan_t *const p_scan)
+{
+    led_scan_step_t step = { 0 };
+    uint32_t        back = 0;
+
+    if ( NULL == p_scan || 0 == p_scan->dirty )
+    {
+        return 0;
+    }
+    p_scan->dirty = 0;
+
+    // the ISR keeps the frame it shows, so the other one is written.
+    p_scan->swap_request = 0;
+    back                 = p_scan->front ^ 1U;
+    for (uint32_t row = 0; row < p_scan->p_config->row_num; row++)
+    {
+        if ( LED_SCAN_CHARLIEPLEX == p_scan->p_config->type )
+        {
+            __scan_charlieplex_row(p_scan, row, &step);
+        }
+        else
+        {
+            __scan_matrix_row(p_scan, row, &step);
+        }
+        p_scan->steps[back][row] = step;
+    }
+    p_scan->swap_request = 1;
+
+    return 1;
+}
+
+uint32_t led_scan_isr(led_scan_t *const p_scan)
+{
+    uint32_t               row    = p_scan->row;
+    const led_scan_step_t *p_step = NULL;
+
+    // a new frame starts, take the steps of the last commit.
+    if ( 0 == row && 0 != p_scan->swap_request )
+    {
+        p_scan->front        ^= 1U;
+        p_scan->swap_request  =  0;
+    }
+
+    // the last row is dark before the columns change, so it never ghosts.
+    p_step                  = &(p_scan->steps[p_scan->front][row]);
+    *(p_scan->p_blank_reg)  =                     p_step->blank;
+    *(p_scan->p_data_reg)   =                      p_step->data;
+    *(p_scan->p_select_reg) =                    p_step->select;
+
+    p_scan->row = (row + 1U < p_scan->p_config->row_num) ? (row + 1U) : 0;
+
+    return p_scan->dwell_us[row];
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_shift.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's output image of a 74HC595 shift register chain.
+ *
+ * Processing flow:
+ *
+ * led_shift_init() -> led_shift_write() per led output -> 
+ * led_shift_commit() per refresh, the stream is shifted out by the SPI of
+ * the system layer and latched at its end.
+ *
+ * The image is one bit per output, kept in the order of the stream, so a 
+ * led costs one bit operation at any length of the chain and a refresh is
+ * one copy. Output 0 is Q0 of the register next to the MCU, whose byte 
+ * is shifted last, MSB first, so bit n of a byte lands on Qn.
+ *
+ * @version V1.0 2025-06-06
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_SHIFT_H__
+#define __BSP_LED_SHIFT_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Outputs of one register                                                  */
+#define LED_SHIFT_REG_OUTPUTS         (8U)
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* Image of the outputs, one byte per register     */
+    uint8_t                                   *p_image;
+    /* Registers of the chain                          */
+    uint32_t                                   reg_num;
+    /* Non-zero if a led is lit at low output level    */
+    uint32_t                                active_low;
+    /* Non-zero if an output changed since the commit  */
+    uint32_t                                     dirty;
+} led_shift_t;
+
+/**
+ * @brief init the image of a chain, every led is off.
+ *
+ * @param[in] self        : Pointer to the image of the chain.
+ * @param[in] p_image     : Storage of the image, reg_num bytes.
+ * @param[in] reg_num     : Registers of the chain, not 0.
+ * @param[in] active_low  : Non-zero if a led is lit at low output level.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_shift_init(
+                                  led_shift_t        *const         self,
+                                  uint8_t            *const      p_image,
+                            const uint32_t                       reg_num,
+                            const uint32_t                    active_low
+                           );
+
+/**
+ * @brief request the level of a led, it is sent by the next commit.
+ *
+ * @param[in] self        : Pointer to the image of the chain.
+ * @param[in] output      : Index of the output along the chain.
+ * @param[in] is_on       : Non-zero to light the led.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_shift_write(
+                                  led_shift_t        *const         self,
+                            const uint32_t                        output,
+                            const uint32_t                         is_on
+                            );
+
+/**
+ * @brief copy the image into the stream if an output changed.
+ *
+ * @param[in]  self        : Pointer to the image of the chain.
+ * @param[out] p_stream    : The stream to be shifted out, reg_num bytes.
+ *
+ * @return uint32_t : 1 if the stream is built, 0 if nothing changed.
+ *
+ * */
+uint32_t led_shift_commit(
+                                  led_shift_t        *const         self,
+                                  uint8_t            *const     p_stream
+                         );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_SHIFT_H__
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_shift.c
+ *
+ * @par dependencies
+ * - bsp_led_shift.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's output image of a 74HC595 shift register chain.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-06-06
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_shift.h"
+#include <string.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+led_status_t led_shift_init(
+                                  led_shift_t        *const         self,
+                                  uint8_t            *const      p_image,
+                            const uint32_t                       reg_num,
+                            const uint32_t                    active_low
+                           )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == self || NULL == p_image || 0 == reg_num )
+    {
+        DEBUG_OUT("Error: led_shift_init Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    self->p_image    =                 p_image;
+    self->reg_num    =                 reg_num;
+    self->active_low = (0 != active_low) ? 1 : 0;
+    self->dirty      =                       1;
+    memset(p_image, (0 != active_low) ? 0xFF : 0x00, reg_num);
+
+    return ret;
+}
+
+led_status_t led_shift_write(
+                                  led_shift_t        *const         self,
+                            const uint32_t                        output,
+                            const uint32_t                         is_on
+                            )
+{
+    led_status_t ret   = LED_OK;
+    uint8_t     *p_reg = NULL;
+    uint8_t      mask  = 0;
+
+    if ( NULL == self || output >= self->reg_num * LED_SHIFT_REG_OUTPUTS )
+    {
+        DEBUG_OUT("Error: led_shift_write Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    // the register next to the MCU is the last byte of the stream.
+    p_reg = &(self->p_image[self->reg_num - 1U -
+                            output / LED_SHIFT_REG_OUTPUTS]);
+    mask  = (uint8_t)(1U << (output % LED_SHIFT_REG_OUTPUTS));
+
+    if ( (0 != is_on) != (0 != self->active_low) )
+    {
+        *p_reg |= mask;
+    }
+    else
+    {
+        *p_reg &= (uint8_t)~mask;
+    }
+    self->dirty = 1;
+
+    return ret;
+}
+
+uint32_t led_shift_commit(
+                                  led_shift_t        *const         self,
+                                  uint8_t            *const     p_stream
+                         )
+{
+    if ( NULL == self || NULL == p_stream || 0 == self->dirty )
+    {
+        return 0;
+    }
+
+    memcpy(p_stream, self->p_image, self->reg_num);
+    self->dirty = 0;
+
+    return 1;
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,172 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_timeline.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's keyframe timelines and their player.
+ *
+ * Processing flow:
+ *
+ * led_timeline_start() per command -> led_timeline_tick() per deadline,
+ * called by led_driver_blink_tick() of the blink engine.
+ *
+ * A timeline is a const table of keyframes in flash, each one a time from
+ * the start and a duty, and the duty between two keyframes is linear. The
+ * set of leds of a timeline is the led of the handler it is played on, a
+ * group of the handler plays it on all of its members in phase. e.g.
+ *
+ *   "heartbeat": { 0, 0 }, { 100, full }, { 250, 0 }, { 350, half },
+ *                { 500, 0 }, { 1200, 0 }, played in a loop.
+ *
+ * The player writes one frame per LED_WAVE_FRAME_MS and steps to the next
+ * keyframe in sequence, a seek to any position is a binary search of the
+ * keyframes, so a long show starts, pauses and resumes at once, without
+ * replaying what is before. A flat part between two keyframes of the same
+ * duty costs no frame.
+ *
+ * @version V1.0 2025-06-24
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_TIMELINE_H__
+#define __BSP_LED_TIMELINE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Position to resume the timeline where it was paused, else from 0        */
+#define LED_TIMELINE_RESUME           (0xFFFFFFFFUL)
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* Time[ms] of the keyframe from the start         */
+    uint32_t                                    time_ms;
+    /* Duty[Q16 of LED_DUTY_FULL] at the keyframe      */
+    led_duty_t                                     duty;
+} led_keyframe_t;
+
+struct led_timeline_s
+{
+    /* Keyframes sorted by time, the first one at 0    */
+    const led_keyframe_t                   *p_keyframes;
+    /* Number of the keyframes, at least one           */
+    uint32_t                               keyframe_num;
+    /* Non-zero to play again from 0 after the last    */
+    uint32_t                                       loop;
+};
+
+/* Heartbeat, two beats and a rest without end                              */
+extern const led_timeline_t led_timeline_heartbeat;
+/* Sunrise, a minute from dark to full along the keyframes                  */
+extern const led_timeline_t led_timeline_sunrise;
+
+/**
+ * @brief find the keyframe the position is after, by a binary search.
+ *
+ * @param[in] p_timeline  : The timeline in flash.
+ * @param[in] pos_ms      : Position[ms] in the timeline.
+ *
+ * @return uint32_t : Index of the last keyframe at or before the position.
+ *
+ * */
+uint32_t led_timeline_seek(
+                            const led_timeline_t     *const   p_timeline,
+                            const uint32_t                        pos_ms
+                          );
+
+/**
+ * @brief get the duty at the position between a keyframe and the next.
+ *
+ * @param[in] p_timeline  : The timeline in flash.
+ * @param[in] key         : Index of the keyframe the position is after.
+ * @param[in] pos_ms      : Position[ms] in the timeline.
+ *
+ * @return led_duty_t : Duty at the position.
+ *
+ * */
+led_duty_t led_timeline_sample(
+                            const led_timeline_t     *const   p_timeline,
+                            const uint32_t                           key,
+                            const uint32_t                        pos_ms
+                              );
+
+/**
+ * @brief load the timeline into the blink engine of the target and write
+ *        its first frame.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] p_timeline  : The timeline in flash.
+ * @param[in] pos_ms      : Position[ms] to start at, or LED_TIMELINE_RESUME.
+ * @param[in] now_us      : Current time base[us].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_timeline_start(
+                                  bsp_led_driver_t   *const      self,
+                            const led_timeline_t     *const p_timeline,
+                            const uint32_t                     pos_ms,
+                            const uint32_t                     now_us
+                               );
+
+/**
+ * @brief write the frame of the timeline whose deadline has expired.
+ *
+ * The position follows the time base by whole milliseconds, so the show
+ * does not drift even if the tick is late, and may be longer than a wrap
+ * of the time base.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] now_us      : Current time base[us].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_timeline_tick(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us
+                              );
+
+/**
+ * @brief keep the position of the timeline being stopped, to resume it.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ * @param[in] end_us      : Time base[us] at which the timeline stops.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_timeline_position_keep(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     end_us
+                                       );
+
+/**
+ * @brief show the duty at the kept position, the engine stays idle.
+ *
+ * @param[in] self        : Pointer to the target of driver.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_timeline_pause(bsp_led_driver_t *const self);
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_TIMELINE_H__
@@ -0,0 +1,338 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_timeline.c
+ *
+ * @par dependencies
+ * - bsp_led_timeline.h
+ * - bsp_led_wave.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's keyframe timelines and their player.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-06-24
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_timeline.h"
+#include "bsp_led_wave.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Time[ms] of the last keyframe, the length of the timeline                */
+#define __TIMELINE_LENGTH_MS(p)                                               \
+    ((p)->p_keyframes[(p)->keyframe_num - 1U].time_ms)
+/* Span[ms] of one wait, so the deadline stays in reach of the time base    */
+#define __TIMELINE_WAIT_MAX_MS        (LED_TIME_SPAN_MAX_US / LED_US_PER_MS)
+
+static const led_keyframe_t led_timeline_heartbeat_keys[] =
+{
+    /* 0 */ {    0,                  0 },
+    /* 1 */ {  100,      LED_DUTY_FULL },
+    /* 2 */ {  250,                  0 },
+    /* 3 */ {  350, LED_DUTY_FULL / 2U },
+    /* 4 */ {  500,                  0 },
+    /* 5 */ { 1200,                  0 },
+};
+
+static const led_keyframe_t led_timeline_sunrise_keys[] =
+{
+    /* 0 */ {     0,                  0 },
+    /* 1 */ { 20000, LED_DUTY_FULL / 64U },
+    /* 2 */ { 40000, LED_DUTY_FULL /  8U },
+    /* 3 */ { 60000,      LED_DUTY_FULL },
+};
+
+const led_timeline_t led_timeline_heartbeat =
+{
+    .p_keyframes  =                                led_timeline_heartbeat_keys,
+    .keyframe_num = sizeof(led_timeline_heartbeat_keys) /
+                    sizeof(led_timeline_heartbeat_keys[0]),
+    .loop         =                                                          1,
+};
+
+const led_timeline_t led_timeline_sunrise =
+{
+    .p_keyframes  =                                  led_timeline_sunrise_keys,
+    .keyframe_num = sizeof(led_timeline_sunrise_keys) /
+                    sizeof(led_timeline_sunrise_keys[0]),
+    .loop         =                                                          0,
+};
+
+/**
+ * @brief bring the position into the timeline, wrapped or held at its end.
+ *
+ * @param[in] p_timeline  : The timeline in flash.
+ * @param[in] pos_ms      : Position[ms], may be past the end.
+ *
+ * @return uint32_t : Position[ms] in [0, length].
+ *
+ * */
+static uint32_t __timeline_position_fit(
+                            const led_timeline_t *const p_timeline,
+                            const uint32_t                  pos_ms
+                                       )
+{
+    uint32_t length_ms = __TIMELINE_LENGTH_MS(p_timeline);
+
+    if ( pos_ms < length_ms )
+    {
+        return pos_ms;
+    }
+
+    return (0 != p_timeline->loop) ? (pos_ms % length_ms) : length_ms;
+}
+
+uint32_t led_timeline_seek(
+                            const led_timeline_t     *const   p_timeline,
+                            const uint32_t                        pos_ms
+                          )
+{
+    uint32_t low  = 0;
+    uint32_t high = p_timeline->keyframe_num - 1U;
+    uint32_t mid  = 0;
+
+    // the first keyframe is at 0, so there is always one at or before.
+    while ( low < high )
+    {
+        mid = (low + high + 1U) >> 1;
+        if ( p_timeline->p_keyframes[mid].time_ms <= pos_ms )
+        {
+            low  =       mid;
+        }
+        else
+        {
+            high = mid - 1U;
+        }
+    }
+
+    return low;
+}
+
+led_duty_t led_timeline_sample(
+                            const led_timeline_t     *const   p_timeline,
+                            const uint32_t                           key,
+                            const uint32_t                        pos_ms
+                              )
+{
+    const led_keyframe_t *p_from = &(p_timeline->p_keyframes[key]);
+    const led_keyframe_t *p_to   = p_from + 1;
+
+    if ( key + 1U >= p_timeline->keyframe_num || pos_ms <= p_from->time_ms )
+    {
+        return p_from->duty;
+    }
+    if ( pos_ms >= p_to->time_ms )
+    {
+        return p_to->duty;
+    }
+
+    // the only division of a frame, the span is not 0 between the two.
+    return (led_duty_t)((int64_t)p_from->duty +
+                        ((int64_t)p_to->duty - (int64_t)p_from->duty) *
+                        (int64_t)(pos_ms - p_from->time_ms) /
+                        (int64_t)(p_to->time_ms - p_from->time_ms));
+}
+
+led_status_t led_timeline_start(
+                                  bsp_led_driver_t   *const      self,
+                            const led_timeline_t     *const p_timeline,
+                            const uint32_t                     pos_ms,
+                            const uint32_t                     now_us
+                               )
+{
+    led_status_t       ret     = LED_OK;
+    led_blink_state_t *p_state = NULL;
+    uint32_t           start   = pos_ms;
+
+    if ( NULL == self || LED_NOT_INITED == self->is_inited )
+    {
+        DEBUG_OUT("Error: The driver has not been initialized!\r\n");
+        ret = LED_ERRORRESOURCE;
+        return ret;
+    }
+
+    if ( NULL == p_timeline                            ||
+         NULL == p_timeline->p_keyframes               ||
+         0    == p_timeline->keyframe_num              ||
+         0    != p_timeline->p_keyframes[0].time_ms    ||
+         ( 0  != p_timeline->loop                   &&
+           0  == __TIMELINE_LENGTH_MS(p_timeline) )
+       )
+    {
+        DEBUG_OUT("Error: led_timeline_start Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    // a fade needs a flicker free period on a duty-cycle backend.
+    ret = led_driver_dim_period_set(self);
+    if (LED_OK != ret)
+    {
+        return ret;
+    }
+
+    p_state = &(self->blink_state);
+    if ( LED_TIMELINE_RESUME == pos_ms )
+    {
+        start = (p_timeline == p_state->p_timeline) ?
+                                    p_state->timeline_pos_ms : 0;
+    }
+    start = __timeline_position_fit(p_timeline, start);
+
+    // the seek is the only search of a start, the frames step in sequence.
+    p_state->p_timeline      =                              p_timeline;
+    p_state->timeline_pos_ms =                                   start;
+    p_state->timeline_key    = led_timeline_seek(p_timeline, start);
+    p_state->epoch_us        =                                  now_us;
+    p_state->wave_start_us   =                                  now_us;
+    p_state->next_edge_us    =                                  now_us;
+    p_state->phase           =                      LED_PHASE_TIMELINE;
+
+    return led_timeline_tick(self, now_us);
+}
+
+led_status_t led_timeline_tick(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     now_us
+                              )
+{
+    led_blink_state_t    *p_state    = &(self->blink_state);
+    const led_timeline_t *p_timeline = p_state->p_timeline;
+    const led_keyframe_t *p_keys     = p_timeline->p_keyframes;
+    uint32_t              length_ms  = __TIMELINE_LENGTH_MS(p_timeline);
+    uint32_t              elapsed_ms = 0;
+    uint32_t              pos        = 0;
+    uint32_t              key        = 0;
+    uint32_t              wait_ms    = 0;
+    uint32_t              end_us     = 0;
+    led_duty_t            duty       = 0;
+
+    if ( LED_PHASE_TIMELINE != p_state->phase ||
+         LED_TIME_BEFORE(now_us, p_state->next_edge_us)
+       )
+    {
+        return LED_OK;
+    }
+
+    // 1. the position follows the time base by whole milliseconds, one
+    //    division per frame.
+    elapsed_ms                = (now_us - p_state->wave_start_us) /
+                                                         LED_US_PER_MS;
+    p_state->wave_start_us   += elapsed_ms * LED_US_PER_MS;
+    p_state->timeline_pos_ms += elapsed_ms;
+    pos                       = p_state->timeline_pos_ms;
+
+    // 2. past the last keyframe the timeline loops or ends on its duty.
+    if ( pos >= length_ms )
+    {
+        if ( 0 == p_timeline->loop )
+        {
+            p_state->phase           =              LED_PHASE_IDLE;
+            p_state->next_edge_us    = p_state->wave_start_us -
+                                       (pos - length_ms) * LED_US_PER_MS;
+            p_state->timeline_pos_ms =                   length_ms;
+            return led_driver_level_write(self,
+                            p_keys[p_timeline->keyframe_num - 1U].duty);
+        }
+        pos                      = pos % length_ms;
+        p_state->timeline_pos_ms =               pos;
+        p_state->timeline_key    =                 0;
+    }
+
+    // 3. the next keyframe in sequence, a search only after a jump.
+    key = p_state->timeline_key;
+    if ( pos < p_keys[key].time_ms )
+    {
+        key = led_timeline_seek(p_timeline, pos);
+    }
+    else if ( pos >= p_keys[key + 1U].time_ms )
+    {
+        key = ( key + 2U < p_timeline->keyframe_num &&
+                pos >= p_keys[key + 2U].time_ms ) ?
+              led_timeline_seek(p_timeline, pos) : (key + 1U);
+    }
+    p_state->timeline_key = key;
+    duty                  = led_timeline_sample(p_timeline, key, pos);
+
+    // 4. one frame later, or the next keyframe if it is sooner or the
+    //    duty is flat up to it.
+    wait_ms = p_keys[key + 1U].time_ms - pos;
+    if ( wait_ms > __TIMELINE_WAIT_MAX_MS )
+    {
+        wait_ms = __TIMELINE_WAIT_MAX_MS;
+    }
+    end_us                = p_state->wave_start_us + wait_ms * LED_US_PER_MS;
+    p_state->next_edge_us = now_us + LED_WAVE_FRAME_MS * LED_US_PER_MS;
+    if ( p_keys[key].duty == p_keys[key + 1U].duty ||
+         !LED_TIME_BEFORE(p_state->next_edge_us, end_us)
+       )
+    {
+        p_state->next_edge_us = end_us;
+    }
+
+    return led_driver_level_write(self, duty);
+}
+
+led_status_t led_timeline_position_keep(
+                                  bsp_led_driver_t   *const      self,
+                            const uint32_t                     end_us
+                                       )
+{
+    led_blink_state_t *p_state = NULL;
+
+    if ( NULL == self || NULL == self->blink_state.p_timeline )
+    {
+        DEBUG_OUT("Error: led_timeline_position_keep Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    p_state = &(self->blink_state);
+    if ( !LED_TIME_BEFORE(end_us, p_state->wave_start_us) )
+    {
+        p_state->timeline_pos_ms = __timeline_position_fit(
+                                    p_state->p_timeline,
+                                    p_state->timeline_pos_ms +
+                                    (end_us - p_state->wave_start_us) /
+                                                       LED_US_PER_MS);
+    }
+
+    return LED_OK;
+}
+
+led_status_t led_timeline_pause(bsp_led_driver_t *const self)
+{
+    const led_timeline_t *p_timeline = NULL;
+    uint32_t              pos        = 0;
+
+    if ( NULL == self || LED_NOT_INITED == self->is_inited )
+    {
+        DEBUG_OUT("Error: The driver has not been initialized!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    // nothing has been played, there is no duty to hold.
+    p_timeline = self->blink_state.p_timeline;
+    if ( NULL == p_timeline )
+    {
+        return LED_OK;
+    }
+
+    pos = self->blink_state.timeline_pos_ms;
+    return led_driver_level_write(self,
+                                  led_timeline_sample(p_timeline,
+                                            led_timeline_seek(p_timeline, pos),
+                                            pos));
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_wave.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ * - arm_math.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's waveform generator of the led brightness.
+ *
+ * Processing flow:
+ *
+ * led_wave_step_calc() per command -> led_wave_sample() per led per frame,
+ * or led_wave_render() for a batch of leds in one frame.
+ *
+ * The phase of a wave is an unsigned Q32 fraction of its cycle, so it wraps
+ * at the end of a cycle by itself and a frame costs no division. The sine
+ * is read from the table-driven arm_cos_q15() of CMSIS-DSP, not from libm.
+ *
+ * @version V1.0 2025-05-20
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_WAVE_H__
+#define __BSP_LED_WAVE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Period[ms] of one duty frame of the waves, 100 frames per second         */
+#ifndef LED_WAVE_FRAME_MS
+#define LED_WAVE_FRAME_MS             (10U)
+#endif
+/* Octaves of the exponential fade, it ends at 1/256 of the peak            */
+#define LED_WAVE_EXP_OCTAVES          (8U)
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    /* Shape of the brightness in one cycle            */
+    led_wave_shape_t                              shape;
+    /* Time base[ms] at which the first cycle starts   */
+    uint32_t                                   start_ms;
+    /* Phase[Q32 of cycle] advanced by one millisecond */
+    uint32_t                                 phase_step;
+    /* Peak duty of the wave                           */
+    led_duty_t                                     peak;
+} led_wave_t;
+
+/**
+ * @brief calculate the phase advanced by one unit of time, it holds the 
+ *        only division of a wave and is called once per command.
+ *
+ * @param[in] cycle_time : The whole time of one cycle, not 0, e.g. in ms
+ *                         for led_wave_render() or in us for the engine.
+ *
+ * @return uint32_t : Phase step[Q32 of cycle] per unit of cycle_time.
+ *
+ * */
+uint32_t led_wave_step_calc(const uint32_t cycle_time);
+
+/**
+ * @brief get the duty of a wave at the phase.
+ *
+ * @param[in] shape       : Shape of the wave.
+ * @param[in] phase       : Phase[Q32 of cycle] in the cycle.
+ * @param[in] peak        : Peak duty of the wave.
+ *
+ * @return led_duty_t : Duty of the wave at the phase.
+ *
+ * */
+led_duty_t led_wave_sample(
+                            const led_wave_shape_t              shape,
+                            const uint32_t                      phase,
+                            const led_duty_t                     peak
+                          );
+
+/**
+ * @brief get the duty of every wave at the time base now_ms.
+ *
+ * @param[in]  p_waves     : The waves of the leds.
+ * @param[in]  wave_num    : Number of the waves.
+ * @param[in]  now_ms      : Current time base[ms].
+ * @param[out] p_duty      : Duty of every wave, wave_num entries.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_wave_render(
+                            const led_wave_t         *const      p_waves,
+                            const uint32_t                      wave_num,
+                            const uint32_t                        now_ms,
+                                  led_duty_t         *const       p_duty
+                            );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_WAVE_H__
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_wave.c
+ *
+ * @par dependencies
+ * - bsp_led_wave.h
+ * - arm_math.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's waveform generator of the led brightness.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-05-20
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_wave.h"
+#include "arm_math.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+/**
+ * @brief calculate the phase advanced by one unit of time, it holds the 
+ *        only division of a wave and is called once per command.
+ *
+ * @param[in] cycle_time : The whole time of one cycle, not 0, e.g. in ms
+ *                         for led_wave_render() or in us for the engine.
+ *
+ * @return uint32_t : Phase step[Q32 of cycle] per unit of cycle_time.
+ *
+ * */
+uint32_t led_wave_step_calc(const uint32_t cycle_time)
+{
+    if ( 0 == cycle_time )
+    {
+        DEBUG_OUT("Error: The cycle time of wave is zero!\r\n");
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)1U << 32) / cycle_time);
+}
+
+/**
+ * @brief get the duty of a wave at the phase.
+ *
+ * @param[in] shape       : Shape of the wave.
+ * @param[in] phase       : Phase[Q32 of cycle] in the cycle.
+ * @param[in] peak        : Peak duty of the wave.
+ *
+ * @return led_duty_t : Duty of the wave at the phase.
+ *
+ * */
+led_duty_t led_wave_sample(
+                            const led_wave_shape_t              shape,
+                            const uint32_t                      phase,
+                            const led_duty_t                     peak
+                          )
+{
+    // raw is the wave in Q16 of the peak, [0, LED_DUTY_FULL].
+    uint32_t raw      = 0;
+    uint32_t phase_16 = phase >> 16;
+    uint32_t exponent = 0;
+    uint32_t octave   = 0;
+
+    switch (shape)
+    {
+        case LED_WAVE_SINE:
+            // (1 - cos) / 2 in Q16 is 0x8000 - cos in Q15, dark at phase 0.
+            raw = (uint32_t)(0x8000 - (int32_t)arm_cos_q15(
+                                                    (q15_t)(phase >> 17)));
+            break;
+        case LED_WAVE_TRIANGLE:
+            raw = (phase_16 < 0x8000U) ? (phase_16 << 1) :
+                                         ((LED_DUTY_FULL - phase_16) << 1);
+            break;
+        case LED_WAVE_EXP:
+            // 2^-x over the octaves, linear between two octaves.
+            exponent = (uint32_t)(((uint64_t)phase * LED_WAVE_EXP_OCTAVES)
+                                                                    >> 16);
+            octave   = exponent >> 16;
+            raw      = LED_DUTY_FULL >> octave;
+            raw     -= (raw * (exponent & 0xFFFFU)) >> 17;
+            break;
+        case LED_WAVE_SQUARE:
+        default:
+            raw = (phase_16 < 0x8000U) ? LED_DUTY_FULL : 0;
+            break;
+    }
+
+    return (led_duty_t)(((uint64_t)raw * peak) >> 16);
+}
+
+/**
+ * @brief get the duty of every wave at the time base now_ms.
+ *
+ * @param[in]  p_waves     : The waves of the leds.
+ * @param[in]  wave_num    : Number of the waves.
+ * @param[in]  now_ms      : Current time base[ms].
+ * @param[out] p_duty      : Duty of every wave, wave_num entries.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_wave_render(
+                            const led_wave_t         *const      p_waves,
+                            const uint32_t                      wave_num,
+                            const uint32_t                        now_ms,
+                                  led_duty_t         *const       p_duty
+                            )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_waves || NULL == p_duty )
+    {
+        DEBUG_OUT("Error: led_wave_render Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    for (uint32_t wave = 0; wave < wave_num; wave++)
+    {
+        // the product wraps at the end of every cycle by itself.
+        p_duty[wave] = led_wave_sample(p_waves[wave].shape,
+                                       (now_ms - p_waves[wave].start_ms) *
+                                                 p_waves[wave].phase_step,
+                                       p_waves[wave].peak);
+    }
+
+    return ret;
+}
+//******************************** Defines **********************************//
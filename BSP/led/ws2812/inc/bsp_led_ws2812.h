@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_ws2812.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's SPI symbol encoder of WS2812 addressable leds.
+ *
+ * Processing flow:
+ *
+ * led_ws2812_pixel_scale() per led output -> led_ws2812_encode() per frame,
+ * the stream is sent by the SPI of the system layer.
+ *
+ * Every data bit of a pixel is 3 SPI bits, 100 for a 0 and 110 for a 1, so
+ * at about 3 MHz the high time is 1/3 or 2/3 of a 1 us bit. A pixel is 24
+ * data bits in G, R, B order, MSB first, so 9 bytes of stream. A 12-bit 
+ * code per nibble is read from a table of 16 entries, so a color byte 
+ * costs two lookups and no loop over its bits.
+ *
+ * @version V1.0 2025-06-04
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_LED_WS2812_H__
+#define __BSP_LED_WS2812_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include <stdint.h>
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* SPI bits per data bit                                                    */
+#define LED_WS2812_SYMBOL_BITS        (3U)
+/* Bytes of stream per pixel, 24 data bits of 3 SPI bits                    */
+#define LED_WS2812_BYTES_PER_PIXEL    (24U * LED_WS2812_SYMBOL_BITS / 8U)
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+typedef struct
+{
+    uint8_t                                           r;
+    uint8_t                                           g;
+    uint8_t                                           b;
+} led_ws2812_pixel_t;
+
+/**
+ * @brief scale a color by a duty, e.g. the brightness of the led.
+ *
+ * @param[in] p_color     : The color at full duty.
+ * @param[in] duty        : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_ws2812_pixel_t : The color at the duty.
+ *
+ * */
+led_ws2812_pixel_t led_ws2812_pixel_scale(
+                            const led_ws2812_pixel_t *const      p_color,
+                            const uint32_t                          duty
+                                         );
+
+/**
+ * @brief encode pixels into the SPI symbol stream.
+ *
+ * @param[in]  p_pixels    : The pixels, in the order of the chain.
+ * @param[in]  pixel_num   : Number of the pixels.
+ * @param[out] p_stream    : The stream, LED_WS2812_BYTES_PER_PIXEL bytes
+ *                           per pixel.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t led_ws2812_encode(
+                            const led_ws2812_pixel_t *const     p_pixels,
+                            const uint32_t                     pixel_num,
+                                  uint8_t            *const     p_stream
+                              );
+//******************************** Declaring ********************************//
+
+#endif // End of __BSP_LED_WS2812_H__
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_led_ws2812.c
+ *
+ * @par dependencies
+ * - bsp_led_ws2812.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief BSP layer's SPI symbol encoder of WS2812 addressable leds.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-06-04
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+#include "bsp_led_ws2812.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* SPI bits of every nibble, MSB first, 100 for a 0 and 110 for a 1         */
+static const uint16_t led_ws2812_nibble[16] = 
+{
+    0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+    0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6,
+};
+
+/**
+ * @brief encode one color byte into 3 bytes of stream.
+ *
+ * @param[in]  value       : The color byte.
+ * @param[out] p_stream    : The 3 bytes of stream.
+ *
+ * */
+static void __ws2812_byte_encode(const uint8_t value, uint8_t *const p_stream)
+{
+    uint32_t code = ((uint32_t)led_ws2812_nibble[value >> 4] << 12) |
+                     (uint32_t)led_ws2812_nibble[value & 0x0FU];
+
+    p_stream[0] = (uint8_t)(code >> 16);
+    p_stream[1] = (uint8_t)(code >>  8);
+    p_stream[2] = (uint8_t)(code      );
+}
+
+led_ws2812_pixel_t led_ws2812_pixel_scale(
+                            const led_ws2812_pixel_t *const      p_color,
+                            const uint32_t                          duty
+                                         )
+{
+    led_ws2812_pixel_t pixel = { 0 };
+
+    if ( NULL == p_color || duty > LED_DUTY_FULL )
+    {
+        DEBUG_OUT("Error: led_ws2812_pixel_scale Parameter error!\r\n");
+        return pixel;
+    }
+
+    // rounded, so the full duty keeps the color.
+    pixel.r = (uint8_t)((p_color->r * duty + LED_DUTY_FULL / 2U) >> 16);
+    pixel.g = (uint8_t)((p_color->g * duty + LED_DUTY_FULL / 2U) >> 16);
+    pixel.b = (uint8_t)((p_color->b * duty + LED_DUTY_FULL / 2U) >> 16);
+
+    return pixel;
+}
+
+led_status_t led_ws2812_encode(
+                            const led_ws2812_pixel_t *const     p_pixels,
+                            const uint32_t                     pixel_num,
+                                  uint8_t            *const     p_stream
+                              )
+{
+    led_status_t ret      = LED_OK;
+    uint8_t     *p_output = p_stream;
+
+    if ( NULL == p_pixels || NULL == p_stream )
+    {
+        DEBUG_OUT("Error: led_ws2812_encode Parameter error!\r\n");
+        ret = LED_ERRORPARAMETER;
+        return ret;
+    }
+
+    for (uint32_t pixel = 0; pixel < pixel_num; pixel++)
+    {
+        // the chain takes green first.
+        __ws2812_byte_encode(p_pixels[pixel].g, &p_output[0]);
+        __ws2812_byte_encode(p_pixels[pixel].r, &p_output[3]);
+        __ws2812_byte_encode(p_pixels[pixel].b, &p_output[6]);
+        p_output += LED_WS2812_BYTES_PER_PIXEL;
+    }
+
+    return ret;
+}
+//******************************** Defines **********************************//
@@ -34,6 +34,12 @@ system_adapter_status_t system_adapter_init_resource(void)
     system_adapter_status_t ret = SYSTEM_ADAPTER_OK;
     DEBUG_OUT("Info: Enter system_adapter_init_resource!\r\n");
 
+    // the blink engines run on the us time base, start it first.
+    if ( 0 == system_time_base_init() )
+    {
+        DEBUG_OUT("Error: The us time base falls back to the HAL tick!\r\n");
+    }
+
     ret = led_handler_inst(&handler            , 
                            &os_delay_handler   , 
                            &os_queue_handler   , 
@@ -73,6 +79,7 @@ void Test_led_handler (void)
     DEBUG_OUT("Begin: --------- Test led handler inst -------------\r\n");
     led_handler_status_t ret = HANDLER_OK;
     bsp_led_handler_t handler1;
+    system_time_base_init();
     ret = led_handler_inst(&handler1           , 
                            &os_delay_handler   , 
                            &os_queue_handler   , 
@@ -106,23 +113,53 @@ void Test_led_handler (void)
                     &led_ops, 
                     &time_base_ms);
 
+    // led_test4 is the blue led, played by the BSRR stream, its blinks and
+    // fades are offloaded to the DMA. Else it is written through the GPIO
+    // port shadow.
     bsp_led_driver_t led_test4;
+#if LED_BSRR_BLUE
+    system_led_bsrr_init(LED_BLUE_GPIO_Port);
     led_driver_inst(&led_test4, 
                     &os_delay_ms, 
-                    &led_ops, 
+                    &led_blue_bsrr_ops, 
+                    &time_base_ms);
+#else
+    system_led_gpio_init();
+    led_driver_inst(&led_test4, 
+                    &os_delay_ms, 
+                    &led_blue_ops, 
+                    &time_base_ms);
+#endif
+
+    // led_test5 is driven by the timer PWM channel.
+    bsp_led_driver_t led_test5;
+    system_led_pwm_init();
+    led_driver_inst(&led_test5, 
+                    &os_delay_ms, 
+                    &led_pwm_ops, 
+                    &time_base_ms);
+
+    // led_test6 is PB0, one of the leds multiplexed by bit-angle modulation.
+    bsp_led_driver_t led_test6;
+    system_led_bam_init();
+    led_driver_inst(&led_test6, 
+                    &os_delay_ms, 
+                    &led_bam_ch0_ops, 
                     &time_base_ms);
 
     DEBUG_OUT("End  : ---------- Test led driver inst -------------\r\n\r\n");
 //**************************** Intergrated Test ***************************//
     DEBUG_OUT("Begin: --------- Test handler register -------------\r\n");
     // mov LED_NOT_INITIALIZED dword ptr [handler_index] -- 线程1
-    led_index_t handler_index[4] = { LED_NOT_INITIALIZED };
+    led_index_t handler_index[6] = { LED_NOT_INITIALIZED };
     ret = handler1.pf_led_register(&handler1, &led_test1, &handler_index[0]);
     ret = handler1.pf_led_register(&handler1, &led_test2, &handler_index[1]);
     ret = handler1.pf_led_register(&handler1, &led_test3, &handler_index[2]);
     ret = handler1.pf_led_register(&handler1, &led_test4, &handler_index[3]);
+    ret = handler1.pf_led_register(&handler1, &led_test5, &handler_index[4]);
+    ret = handler1.pf_led_register(&handler1, &led_test6, &handler_index[5]);
 
-    for (uint8_t i = 0; i < 4; i++)
+    for (uint8_t i = 0; i < 6; i++)
     {
         printf("handler_index[%d] = [%d]\r\n", i, handler_index[i]);
     }
@@ -133,6 +170,56 @@ void Test_led_handler (void)
         return;
     }
 
+    // led_test2 and led_test3 blink in phase as one group.
+    led_index_t group_members[2] = { handler_index[1], handler_index[2] };
+    led_index_t group_index      =                 LED_NOT_INITIALIZED;
+    ret = handler1.pf_handler_group_create(&handler1, group_members, 2,
+                                           &group_index);
+    if ( HANDLER_OK != ret )
+    {
+        DEBUG_OUT("Error: Test handler group failed!\r\n");
+        return;
+    }
+
+    // led_test7 shares the bam flush of led_test6, so a group of led_test1
+    // and led_test6 would move it to another worker while it blinks.
+    bsp_led_driver_t led_test7;
+    led_index_t      mate_index  =              LED_NOT_INITIALIZED;
+    led_index_t      busy_members[2] = { handler_index[0], handler_index[5] };
+    led_index_t      busy_index  =              LED_NOT_INITIALIZED;
+    uint8_t          busy_dispatch[3] = { 0 };
+    led_driver_inst(&led_test7, 
+                    &os_delay_ms, 
+                    &led_bam_ch1_ops, 
+                    &time_base_ms);
+    ret = handler1.pf_led_register(&handler1, &led_test7, &mate_index);
+    handler1.pf_handler_led_controler(&handler1,
+                                      mate_index,
+                                      1000,
+                                      10,
+                                      LED_DUTY_1_2);
+    // the workers start late, wait until the blink of led_test7 runs.
+    for ( uint32_t wait_ms = 0; 
+          LED_PHASE_IDLE == led_test7.blink_state.phase && wait_ms < 5000;
+          wait_ms += 10 )
+    {
+        osDelay(10);
+    }
+    busy_dispatch[0] = handler1.thread_pool.dispatch[handler_index[0]];
+    busy_dispatch[1] = handler1.thread_pool.dispatch[handler_index[5]];
+    busy_dispatch[2] = handler1.thread_pool.dispatch[mate_index];
+    ret = handler1.pf_handler_group_create(&handler1, busy_members, 2,
+                                           &busy_index);
+    if ( HANDLER_ERRORRESOURCE != ret                                        ||
+         busy_dispatch[0] != handler1.thread_pool.dispatch[handler_index[0]] ||
+         busy_dispatch[1] != handler1.thread_pool.dispatch[handler_index[5]] ||
+         busy_dispatch[2] != handler1.thread_pool.dispatch[mate_index]
+       )
+    {
+        DEBUG_OUT("Error: Test handler group moved a busy led!\r\n");
+        return;
+    }
+
     DEBUG_OUT("End  : --------- Test handler register -------------\r\n\r\n");
 //********************* The external API for AP ***************************//
     DEBUG_OUT("Begin: --------- Test handler controler ------------\r\n");
@@ -141,24 +228,113 @@ void Test_led_handler (void)
                                       handler_index[0], // 线程2, 优先于线程1执行
                                       5,
                                       5,
-                                      PROPORTION_ON_OFF_1_1);
+                                      LED_DUTY_1_1);
+    // a 500 us blink of led_test5 for 1 s, below the OS tick.
+    handler1.pf_handler_led_control_us(&handler1,
+                                       handler_index[4],
+                                       500,
+                                       2000,
+                                       LED_DUTY_1_2);
+    // the whole sequence of led_test5 is offloaded to the timer.
+    handler1.pf_handler_led_controler(&handler1,
+                                      handler_index[4],
+                                      1000,
+                                      10,
+                                      LED_DUTY_1_3);
+    // then let led_test5 breathe 3 times, 2 s per breath.
+    handler1.pf_handler_led_wave(&handler1,
+                                 handler_index[4],
+                                 LED_WAVE_SINE,
+                                 2000,
+                                 3,
+                                 LED_DUTY_FULL);
+    // dim led_test5 to half the perceived brightness after its blinks.
+    handler1.pf_handler_led_brightness(&handler1,
+                                       handler_index[4],
+                                       128);
+    // led_test6 is dimmed like any other led with a duty-cycle backend.
+    handler1.pf_handler_led_brightness(&handler1,
+                                       handler_index[5],
+                                       64);
+    // the members start their own blinks after the 3 blinks of the group.
+    handler1.pf_handler_led_controler(&handler1,
+                                      group_index,
+                                      500,
+                                      3,
+                                      LED_DUTY_1_1);
+    // led_test1 plays 3 short and 1 long blinks from the flash table.
+    handler1.pf_handler_led_pattern(&handler1,
+                                    handler_index[0],
+                                    led_pattern_3_short_1_long);
+    // the driver's API only posts the request, wait for its end here.
+    osEventFlagsId_t blink_done = osEventFlagsNew(NULL);
+    led_completion_t completion = 
+    {
+        .pf_done       = NULL              ,
+        .p_arg         = NULL              ,
+        .p_event_flags = (void *)blink_done,
+        .flags         = 0x01U             ,
+    };
+    if ( NULL != blink_done &&
+         LED_OK == led_test1.pf_led_controler(&led_test1,
+                                              100,
+                                              5,
+                                              LED_DUTY_1_1,
+                                              &completion)
+       )
+    {
+        osEventFlagsWait(blink_done, 0x01U, osFlagsWaitAny, osWaitForever);
+        DEBUG_OUT("Info: The async blink of led_test1 is done!\r\n");
+    }
+    // a blink of hours on led_test4 is replaced at its next edge.
+    handler1.pf_handler_led_controler(&handler1,
+                                      handler_index[3],
+                                      9999,
+                                      999,
+                                      LED_DUTY_1_2);
+    led_event_t replace_request = 
+    {
+        .index             = handler_index[3]     ,
+        .type              = LED_EVENT_BLINK      ,
+        .cycle_time_us     = 500 * LED_US_PER_MS  ,
+        .blink_times       = 2                    ,
+        .duty              = LED_DUTY_1_2         ,
+        .shape             = LED_WAVE_SQUARE      ,
+        .policy            = LED_POLICY_NOW       ,
+    };
+    handler1.pf_handler_led_request(&handler1, &replace_request);
+    // led_test6 plays the heartbeat from flash, paused for a second.
+    handler1.pf_handler_led_timeline(&handler1,
+                                     handler_index[5],
+                                     &led_timeline_heartbeat,
+                                     0);
+    osDelay(3000);
+    handler1.pf_handler_led_timeline(&handler1,
+                                     handler_index[5],
+                                     NULL,
+                                     0);
+    osDelay(1000);
+    handler1.pf_handler_led_timeline(&handler1,
+                                     handler_index[5],
+                                     &led_timeline_heartbeat,
+                                     LED_TIMELINE_RESUME);
     for (;;)
     {
         handler1.pf_handler_led_controler(&handler1,
                                           handler_index[1],
                                           2,
                                           1,
-                                          PROPORTION_ON_OFF_1_1);
+                                          LED_DUTY_1_1);
         handler1.pf_handler_led_controler(&handler1,
                                           handler_index[2],
                                           1,
                                           1,
-                                          PROPORTION_ON_OFF_1_2);
+                                          LED_DUTY_1_2);
         handler1.pf_handler_led_controler(&handler1,
                                           handler_index[3],
                                           3,
                                           2,
-                                          PROPORTION_ON_OFF_1_3);
+                                          LED_DUTY_RATIO(2, 5));
         osDelay(3000);
     }
 
@@ -167,4 +343,1332 @@ void Test_led_handler (void)
 
     while(1);
 }
+/**
+ * @brief  Unit test for the BSRR renderer, no hardware is touched.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_render (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led render bsrr ------------\r\n");
+    uint32_t           failed    = 0;
+    uint32_t           whole[12] = { 0 };
+    uint32_t           chunk[12] = { 0 };
+    led_render_track_t tracks[2];
+    /* 4 samples cycle, 1:1, 2 times, pin 13 from sample 2 */
+    led_event_t        event1    = 
+    {
+        .index             = LED_HANDLER_NO_1     ,
+        .cycle_time_us     = 4 * LED_RENDER_SAMPLE_US,
+        .blink_times       = 2                    ,
+        .duty              = LED_DUTY_1_1         ,
+    };
+    /* 3 samples cycle, 1:2, 3 times, pin 0 from sample 0 */
+    led_event_t        event2    = 
+    {
+        .index             = LED_HANDLER_NO_2     ,
+        .cycle_time_us     = 3 * LED_RENDER_SAMPLE_US,
+        .blink_times       = 3                    ,
+        .duty              = LED_DUTY_1_2         ,
+    };
+    const uint32_t S13 = 1U << 13, R13 = 1U << (13 + 16);
+    const uint32_t S0  = 1U << 0 , R0  = 1U << (0  + 16);
+    const uint32_t expected[12] = 
+    {
+        S0      , R0      , R0 | S13, S0 | S13, R0 | R13, R0 | R13,
+        S0 | S13, R0 | S13, R0 | R13, R0 | R13, R0 | R13, R0 | R13,
+    };
+
+    // case 1: one chunk renders the expected words.
+    led_render_track_init(&tracks[0], &event1, 1U << 13, 2);
+    led_render_track_init(&tracks[1], &event2, 1U << 0 , 0);
+    led_render_bsrr(tracks, 2, 0, whole, 12);
+    for (uint32_t i = 0; i < 12; i++)
+    {
+        if ( expected[i] != whole[i] )
+        {
+            printf("Error: sample[%d] = 0x%08x, expected 0x%08x\r\n",
+                   i, whole[i], expected[i]);
+            failed++;
+        }
+    }
+
+    // case 2: ring refills in chunks give the same words.
+    led_render_bsrr(tracks, 2, 0, &chunk[0], 5);
+    led_render_bsrr(tracks, 2, 5, &chunk[5], 7);
+    if ( 0 != memcmp(whole, chunk, sizeof(whole)) )
+    {
+        DEBUG_OUT("Error: chunked render differs from whole render!\r\n");
+        failed++;
+    }
+
+    // case 3: invalid parameters are rejected.
+    if ( LED_OK == led_render_track_init(&tracks[0], &event1, 0, 0) )
+    {
+        DEBUG_OUT("Error: empty pin mask is accepted!\r\n");
+        failed++;
+    }
+
+    // case 4: an active low led resets its pin in the on time.
+    led_render_track_init(&tracks[1], &event2, 1U << 0 , 0);
+    tracks[1].is_active_low = 1;
+    led_render_bsrr(&tracks[1], 1, 0, chunk, 3);
+    if ( R0 != chunk[0] || S0 != chunk[1] || S0 != chunk[2] )
+    {
+        DEBUG_OUT("Error: an active low led is not swapped!\r\n");
+        failed++;
+    }
+
+    printf("Info: Test led render failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led render bsrr ------------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the CIE1931 brightness table, no hardware is touched.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_gamma (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led gamma table ------------\r\n");
+    uint32_t failed = 0;
+
+    // case 1: the ends of the table are off and full on.
+    if ( 0             != led_gamma_cie1931[0]                   ||
+         LED_DUTY_FULL != led_gamma_cie1931[LED_GAMMA_LEVEL_MAX]
+       )
+    {
+        DEBUG_OUT("Error: the ends of the gamma table are wrong!\r\n");
+        failed++;
+    }
+
+    // case 2: the duty never decreases with the level.
+    for (uint32_t level = 1; level < LED_GAMMA_LEVEL_NUM; level++)
+    {
+        if ( led_gamma_cie1931[level] < led_gamma_cie1931[level - 1] )
+        {
+            printf("Error: gamma[%d] = %d is below the level before\r\n",
+                   level, led_gamma_cie1931[level]);
+            failed++;
+        }
+    }
+
+    // case 3: L* = 50 is about 18.4% of the luminance.
+    if ( led_gamma_cie1931[128] < LED_DUTY_RATIO(18, 82) ||
+         led_gamma_cie1931[128] > LED_DUTY_RATIO(19, 81)
+       )
+    {
+        printf("Error: gamma[128] = %d is off the curve\r\n",
+               led_gamma_cie1931[128]);
+        failed++;
+    }
+
+    printf("Info: Test led gamma failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led gamma table ------------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Start a benchmark on the cycle counter of DWT.
+ *         CYCCNT is not reset, it is the us time base of the engines.
+ * @param  None
+ * @retval The cycle count the benchmark is measured from.
+ */
+static uint32_t __bench_cycles_start (void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |=     DWT_CTRL_CYCCNTENA_Msk;
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief  Unit test and benchmark for the wave generator, only DWT is used.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_wave (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led wave generator ---------\r\n");
+    uint32_t   failed     = 0;
+    uint32_t   cycles     = 0;
+    /* 16 leds of every shape for the benchmark */
+    led_wave_t waves[16];
+    led_duty_t duty[16];
+    const uint32_t half   = 0x80000000U;
+    const uint32_t margin = LED_DUTY_FULL / 256U;
+
+    // case 1: the ends of every shape.
+    if ( led_wave_sample(LED_WAVE_SINE    , 0          , LED_DUTY_FULL) 
+                                                    >  margin                 ||
+         led_wave_sample(LED_WAVE_SINE    , half       , LED_DUTY_FULL) 
+                                                    <  LED_DUTY_FULL - margin ||
+         led_wave_sample(LED_WAVE_TRIANGLE, 0          , LED_DUTY_FULL) 
+                                                    != 0                      ||
+         led_wave_sample(LED_WAVE_TRIANGLE, half       , LED_DUTY_FULL) 
+                                                    != LED_DUTY_FULL          ||
+         led_wave_sample(LED_WAVE_EXP     , 0          , LED_DUTY_FULL) 
+                                                    != LED_DUTY_FULL          ||
+         led_wave_sample(LED_WAVE_EXP     , 0xFFFFFFFFU, LED_DUTY_FULL) 
+                                                    >  2U * margin            ||
+         led_wave_sample(LED_WAVE_SQUARE  , half       , LED_DUTY_FULL) 
+                                                    != 0
+       )
+    {
+        DEBUG_OUT("Error: the ends of the wave shapes are wrong!\r\n");
+        failed++;
+    }
+
+    // case 2: the peak scales the wave.
+    if ( LED_DUTY_FULL / 2U != 
+         led_wave_sample(LED_WAVE_TRIANGLE, half, LED_DUTY_FULL / 2U) )
+    {
+        DEBUG_OUT("Error: the peak does not scale the wave!\r\n");
+        failed++;
+    }
+
+    // case 3: the phase wraps at the end of every cycle.
+    waves[0].shape      =                  LED_WAVE_TRIANGLE;
+    waves[0].start_ms   =                                100;
+    waves[0].phase_step =            led_wave_step_calc(400);
+    waves[0].peak       =                      LED_DUTY_FULL;
+    led_wave_render(waves, 1, 100 + 400 * 5 + 200, duty);
+    if ( duty[0] < LED_DUTY_FULL - margin )
+    {
+        printf("Error: wave at half of cycle 6 = 0x%x\r\n", duty[0]);
+        failed++;
+    }
+
+    // case 4: cycles per led of one frame.
+    for (uint32_t led = 0; led < 16; led++)
+    {
+        waves[led].shape      = (led_wave_shape_t)(led % LED_WAVE_NUM);
+        waves[led].start_ms   =                                     0;
+        waves[led].phase_step =         led_wave_step_calc(1000 + led);
+        waves[led].peak       =                         LED_DUTY_FULL;
+    }
+    cycles = __bench_cycles_start();
+    led_wave_render(waves, 16, 12345, duty);
+    cycles = DWT->CYCCNT - cycles;
+    printf("Info: led_wave_render costs %d cycles per led\r\n", cycles / 16);
+
+    printf("Info: Test led wave failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led wave generator ---------\r\n\r\n");
+    return failed;
+}
+
+/* Duty written by the fake led of Test_led_pattern                         */
+static led_duty_t s_pattern_duty = 0;
+
+static led_status_t __pattern_fake_on (void)
+{
+    s_pattern_duty = LED_DUTY_FULL;
+    return LED_OK;
+}
+
+static led_status_t __pattern_fake_off (void)
+{
+    s_pattern_duty = 0;
+    return LED_OK;
+}
+
+static led_status_t __pattern_fake_duty (const uint32_t duty)
+{
+    s_pattern_duty = duty;
+    return LED_OK;
+}
+
+static led_status_t __pattern_fake_period (const uint32_t period_us)
+{
+    return LED_OK;
+}
+
+/* The fake leds write s_pattern_duty, a pwm one can offload a blink        */
+static const led_operations_t s_pattern_switch_ops = 
+{
+    .pf_led_on         = __pattern_fake_on    ,
+    .pf_led_off        = __pattern_fake_off   ,
+};
+
+static const led_operations_t s_pattern_pwm_ops = 
+{
+    .pf_led_on         = __pattern_fake_on    ,
+    .pf_led_off        = __pattern_fake_off   ,
+    .pf_led_set_duty   = __pattern_fake_duty  ,
+    .pf_led_set_period = __pattern_fake_period,
+};
+
+/* The us time base of a fake led wraps 65 ms after the start, in the middle
+   of what it plays                                                         */
+#define PATTERN_FAKE_BASE_US                                      0xFFFF0000U
+
+/**
+ * @brief  Initialize a fake led of the virtual time tests, it is off and
+ *         has no command, the test sets its own cycle, count and shape.
+ * @param  p_led : the fake led.
+ * @param  p_ops : s_pattern_switch_ops or s_pattern_pwm_ops.
+ * @retval None
+ */
+static void __pattern_fake_init (      bsp_led_driver_t *const p_led,
+                                 const led_operations_t *const p_ops)
+{
+    const bsp_led_driver_t led_fake = 
+    {
+        .is_inited         = LED_INITED           ,
+        .p_led_opes        = p_ops                ,
+    };
+    *p_led         = led_fake;
+    s_pattern_duty =        0;
+}
+
+/**
+ * @brief  Unit test for the pattern interpreter, a fake led is driven.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_pattern (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led pattern bytecode -------\r\n");
+    uint32_t         failed    = 0;
+    uint32_t         edges     = 0;
+    uint32_t         next_us   = 0;
+    led_duty_t       duty_last = 0;
+    const uint32_t   base_us   = PATTERN_FAKE_BASE_US;
+    bsp_led_driver_t led_fake;
+    /* time[ms] and duty of every edge of 3 short 1 long */
+    const uint32_t   edge_ms[8]   = 
+    {
+        0   , 100 , 200 , 300 , 400 , 500 , 1000, 1800,
+    };
+    const led_pattern_op_t loop[] = { LED_PAT_JUMP(0) };
+    __pattern_fake_init(&led_fake, &s_pattern_pwm_ops);
+
+    // case 1: the edges of 3 short 1 long, ticked every millisecond.
+    led_pattern_start(&led_fake, led_pattern_3_short_1_long, base_us);
+    for (uint32_t t = 0; t < 2200; t++)
+    {
+        led_driver_blink_tick(&led_fake, base_us + t * LED_US_PER_MS,
+                              &next_us);
+        if ( s_pattern_duty == duty_last )
+        {
+            continue;
+        }
+        if ( edges >= 8 || edge_ms[edges] != t ||
+             ((0 == edges % 2) ? LED_DUTY_FULL : 0) != s_pattern_duty
+           )
+        {
+            printf("Error: edge %d at %d ms is not expected\r\n", edges, t);
+            failed++;
+        }
+        duty_last = s_pattern_duty;
+        edges++;
+    }
+    if ( 8 != edges || LED_PHASE_IDLE == led_fake.blink_state.phase )
+    {
+        DEBUG_OUT("Error: the pattern does not play to its end!\r\n");
+        failed++;
+    }
+    led_driver_blink_tick(&led_fake, base_us + 2200 * LED_US_PER_MS,
+                          &next_us);
+    if ( LED_PHASE_IDLE != led_fake.blink_state.phase || 0 != s_pattern_duty )
+    {
+        DEBUG_OUT("Error: END does not leave the led idle and off!\r\n");
+        failed++;
+    }
+
+    // case 2: a late tick catches up without drifting.
+    led_pattern_start(&led_fake, led_pattern_3_short_1_long, 0);
+    led_driver_blink_tick(&led_fake, 1050 * LED_US_PER_MS, &next_us);
+    if ( LED_DUTY_FULL != s_pattern_duty || 1800 * LED_US_PER_MS != next_us )
+    {
+        printf("Error: late tick gives 0x%x, next at %d us\r\n",
+               s_pattern_duty, next_us);
+        failed++;
+    }
+
+    // case 3: ramps follow the brightness table and reach their target.
+    led_pattern_start(&led_fake, led_pattern_breathe, 0);
+    for (uint32_t t = 0; t <= 3000; t++)
+    {
+        led_driver_blink_tick(&led_fake, t * LED_US_PER_MS, &next_us);
+        if ( ( 750  == t && led_gamma_cie1931[127] != s_pattern_duty ) ||
+             ( 1500 == t && LED_DUTY_FULL          != s_pattern_duty ) ||
+             ( 3000 == t && 0                      != s_pattern_duty )
+           )
+        {
+            printf("Error: ramp at %d ms = 0x%x\r\n", t, s_pattern_duty);
+            failed++;
+        }
+    }
+    if ( LED_PHASE_IDLE == led_fake.blink_state.phase )
+    {
+        DEBUG_OUT("Error: the breathing pattern stops!\r\n");
+        failed++;
+    }
+
+    // case 4: a pattern which never waits is stopped.
+    if ( LED_ERROR      != led_pattern_start(&led_fake, loop, 0) ||
+         LED_PHASE_IDLE != led_fake.blink_state.phase
+       )
+    {
+        DEBUG_OUT("Error: the endless jump is not stopped!\r\n");
+        failed++;
+    }
+
+    printf("Info: Test led pattern failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led pattern bytecode -------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the port shadow, fake BSRR words are written.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_port (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led port shadow ------------\r\n");
+    uint32_t          failed  = 0;
+    uint32_t          stores  = 0;
+    volatile uint32_t bsrr[2] = { 0 };
+    led_port_t        ports[2];
+
+    // pin 13 of port 0 is high, e.g. an active low led which is off.
+    led_port_init(&ports[0], &bsrr[0], 1U << 13);
+    led_port_init(&ports[1], &bsrr[1], 0);
+
+    // case 1: the leds of one port changed in a tick cost one word.
+    led_port_pin_write(&ports[0], 1U << 13, 0);
+    led_port_pin_write(&ports[0], 1U << 1 , 1);
+    led_port_pin_write(&ports[0], 1U << 2 , 0);
+    stores = led_port_flush(ports, 2);
+    if ( 1 != stores || ((1U << 1) | (1U << (13 + 16))) != bsrr[0] )
+    {
+        printf("Error: %d words, bsrr = 0x%08x\r\n", stores, bsrr[0]);
+        failed++;
+    }
+
+    // case 2: the levels written again or changed back cost nothing.
+    bsrr[0] = 0;
+    led_port_pin_write(&ports[0], 1U << 13, 0);
+    led_port_pin_write(&ports[0], 1U << 1 , 0);
+    led_port_pin_write(&ports[0], 1U << 1 , 1);
+    stores = led_port_flush(ports, 2);
+    if ( 0 != stores || 0 != bsrr[0] )
+    {
+        DEBUG_OUT("Error: unchanged pins are stored!\r\n");
+        failed++;
+    }
+
+    // case 3: every changed port gets its own word.
+    led_port_pin_write(&ports[0], 1U << 1 , 0);
+    led_port_pin_write(&ports[1], 1U << 7 , 1);
+    stores = led_port_flush(ports, 2);
+    if ( 2 != stores || (1U << (1 + 16)) != bsrr[0] || (1U << 7) != bsrr[1] )
+    {
+        printf("Error: %d words, bsrr = 0x%08x 0x%08x\r\n",
+               stores, bsrr[0], bsrr[1]);
+        failed++;
+    }
+
+    printf("Info: Test led port failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led port shadow ------------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the us time base and a sub-millisecond blink.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_time_base (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led us time base -----------\r\n");
+    uint32_t         failed        = 0;
+    uint32_t         edges         = 0;
+    uint32_t         next_us       = 0;
+    uint32_t         cycles_per_us = 0;
+    uint32_t         start_us      = 0;
+    uint32_t         start_ms      = 0;
+    int32_t          drift_ms      = 0;
+    led_duty_t       duty_last     = 0;
+    /* the us time base wraps at the second blink */
+    const uint32_t   base_us       = 0xFFFFFD00U;
+    bsp_led_driver_t led_fake;
+    /* time[us] of every edge, on at the even ones */
+    const uint32_t   edge_us[6]    = { 0, 250, 500, 750, 1000, 1250 };
+    /* 500 us cycle, 1:1, 3 times, driven by the engine in software */
+    __pattern_fake_init(&led_fake, &s_pattern_switch_ops);
+    led_fake.cycle_time_us = 500;
+    led_fake.blink_times   = 3;
+    led_fake.duty          = LED_DUTY_1_1;
+    led_fake.shape         = LED_WAVE_SQUARE;
+
+    // case 1: the edges of a 500 us blink, ticked every 10 us.
+    led_driver_blink_start(&led_fake, base_us);
+    for (uint32_t t = 0; t < 2000; t += 10)
+    {
+        led_driver_blink_tick(&led_fake, base_us + t, &next_us);
+        if ( s_pattern_duty == duty_last )
+        {
+            continue;
+        }
+        if ( edges >= 6 || edge_us[edges] != t ||
+             ((0 == edges % 2) ? LED_DUTY_FULL : 0) != s_pattern_duty
+           )
+        {
+            printf("Error: edge %d at %d us is not expected\r\n", edges, t);
+            failed++;
+        }
+        duty_last = s_pattern_duty;
+        edges++;
+    }
+    if ( 6 != edges || LED_PHASE_IDLE != led_fake.blink_state.phase )
+    {
+        DEBUG_OUT("Error: the sub-ms blink does not play to its end!\r\n");
+        failed++;
+    }
+
+    // case 2: the us time base keeps pace with the HAL tick.
+    cycles_per_us = system_time_base_init();
+    if ( 0 == cycles_per_us )
+    {
+        DEBUG_OUT("Error: the us time base can not be started!\r\n");
+        failed++;
+        return failed;
+    }
+    start_us = system_time_base_us();
+    start_ms = HAL_GetTick();
+    osDelay(100);
+    drift_ms = (int32_t)((system_time_base_us() - start_us) / LED_US_PER_MS) -
+               (int32_t)(HAL_GetTick() - start_ms);
+    if ( drift_ms > 1 || drift_ms < -1 )
+    {
+        printf("Error: the us time base drifts %d ms\r\n", drift_ms);
+        failed++;
+    }
+
+    // case 3: CYCCNT wraps 10 ms after the restart, the time base does not.
+    DWT->CYCCNT   = 0U - 10U * LED_US_PER_MS * cycles_per_us;
+    system_time_base_init();
+    start_us = system_time_base_us();
+    start_ms = HAL_GetTick();
+    while ( DWT->CYCCNT > 0x80000000U )
+    {
+    }
+    osDelay(20);
+    drift_ms = (int32_t)((system_time_base_us() - start_us) / LED_US_PER_MS) -
+               (int32_t)(HAL_GetTick() - start_ms);
+    if ( drift_ms > 1 || drift_ms < -1 )
+    {
+        printf("Error: the wrap of CYCCNT costs %d ms\r\n", drift_ms);
+        failed++;
+    }
+
+    printf("Info: Test led time base failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led us time base -----------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the bit-angle modulation, fake BSRR words are written.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_bam (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led bam bitplanes ----------\r\n");
+    uint32_t          failed     = 0;
+    uint32_t          weight     = 0;
+    uint32_t          on_time[3] = { 0 };
+    volatile uint32_t bsrr[LED_BAM_PORT_NUM] = { 0 };
+    volatile uint32_t *p_bsrr[LED_BAM_PORT_NUM];
+    led_bam_t         bam;
+    /* pin 0 and active low pin 1 of port 0, pin 3 of port 1 */
+    const led_bam_channel_t channels[3] = 
+    {
+        { 0, 0, 1U << 0 }, { 0, 1, 1U << 1 }, { 1, 0, 1U << 3 },
+    };
+    const uint32_t    levels[3]  = { 5, 200, LED_BAM_LEVEL_MAX };
+
+    for (uint32_t port = 0; port < LED_BAM_PORT_NUM; port++)
+    {
+        p_bsrr[port] = (port < 2) ? &bsrr[port] : NULL;
+    }
+    led_bam_init(&bam, p_bsrr, channels, 3);
+    for (uint32_t channel = 0; channel < 3; channel++)
+    {
+        led_bam_level_set(&bam, channel, levels[channel]);
+    }
+    led_bam_commit(&bam);
+
+    // case 1: one frame of LED_BAM_BITS interrupts shows every level.
+    for (uint32_t bit = 0; bit < LED_BAM_BITS; bit++)
+    {
+        weight      = led_bam_isr(&bam);
+        on_time[0] += (0 != (bsrr[0] & (1U << 0)))        ? weight : 0;
+        on_time[1] += (0 != (bsrr[0] & (1U << (1 + 16)))) ? weight : 0;
+        on_time[2] += (0 != (bsrr[1] & (1U << 3)))        ? weight : 0;
+    }
+    for (uint32_t channel = 0; channel < 3; channel++)
+    {
+        if ( levels[channel] != on_time[channel] )
+        {
+            printf("Error: led %d is on %d of %d\r\n",
+                   channel, on_time[channel], levels[channel]);
+            failed++;
+        }
+    }
+
+    // case 2: a commit in the middle of a frame waits for the next one.
+    led_bam_isr(&bam);
+    led_bam_level_set(&bam, 0, LED_BAM_LEVEL_MAX);
+    led_bam_commit(&bam);
+    for (uint32_t bit = 1; bit < LED_BAM_BITS; bit++)
+    {
+        led_bam_isr(&bam);
+        if ( ((levels[0] >> bit) & 1U) != (bsrr[0] & (1U << 0)) )
+        {
+            printf("Error: bit %d of led 0 is torn\r\n", bit);
+            failed++;
+        }
+    }
+    led_bam_isr(&bam);
+    if ( 0 == (bsrr[0] & (1U << 0)) )
+    {
+        DEBUG_OUT("Error: the new level is not shown by the next frame!\r\n");
+        failed++;
+    }
+
+    // case 3: nothing is built while no level changes.
+    if ( 0 != led_bam_commit(&bam) )
+    {
+        DEBUG_OUT("Error: the bitplanes are rebuilt without change!\r\n");
+        failed++;
+    }
+
+    printf("Info: Test led bam failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led bam bitplanes ----------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the row scan, fake GPIO registers are written.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_scan (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led scan matrix ------------\r\n");
+    uint32_t          failed     = 0;
+    uint32_t          dwell_us   = 0;
+    volatile uint32_t row_bsrr   = 0;
+    volatile uint32_t col_bsrr   = 0;
+    volatile uint32_t moder      = 0;
+    led_scan_t        scan;
+    /* 3 x 4 matrix, rows on pins 0-2 active high, columns on pins 4-7 
+       lit at low level */
+    const uint16_t    row_pins[3] = { 1U << 0, 1U << 1, 1U << 2 };
+    const uint16_t    col_pins[4] = { 1U << 4, 1U << 5, 1U << 6, 1U << 7 };
+    const led_scan_config_t matrix = 
+    {
+        .type           = LED_SCAN_MATRIX,
+        .row_num        = 3              ,
+        .col_num        = 4              ,
+        .p_row_pins     = row_pins       ,
+        .p_col_pins     = col_pins       ,
+        .row_active_low = 0              ,
+        .col_active_low = 1              ,
+        .p_row_bsrr     = &row_bsrr      ,
+        .p_col_bsrr     = &col_bsrr      ,
+        .dwell_us       = 500            ,
+    };
+    /* 3 charlieplexed pins 0-2, the other pins of the port are outputs */
+    const led_scan_config_t charlieplex = 
+    {
+        .type           = LED_SCAN_CHARLIEPLEX,
+        .row_num        = 3                   ,
+        .col_num        = 3                   ,
+        .p_row_pins     = row_pins            ,
+        .p_row_bsrr     = &row_bsrr           ,
+        .p_moder        = &moder              ,
+        .dwell_us       = 500                 ,
+    };
+
+    // case 1: every row of the matrix lights its own cells.
+    led_scan_init(&scan, &matrix);
+    led_scan_cell_write(&scan, LED_SCAN_CELL(0, 1, 4), 1);
+    led_scan_cell_write(&scan, LED_SCAN_CELL(2, 3, 4), 1);
+    led_scan_dwell_set(&scan, 1, 300);
+    led_scan_commit(&scan);
+    for (uint32_t row = 0; row < 3; row++)
+    {
+        dwell_us = led_scan_isr(&scan);
+        // the select word resets the other rows and sets this one.
+        if ( (((0x07U & ~row_pins[row]) << 16) | row_pins[row]) != 
+                                                               row_bsrr ||
+             ((1 == row) ? 300 : 500) != dwell_us
+           )
+        {
+            printf("Error: row %d select 0x%08x, dwell %d us\r\n",
+                   row, row_bsrr, dwell_us);
+            failed++;
+        }
+    }
+    if ( (((1U << 7) << 16) | 0x70U) != col_bsrr )
+    {
+        printf("Error: the columns of row 2 are 0x%08x\r\n", col_bsrr);
+        failed++;
+    }
+
+    // case 2: a charlieplexed anode drives only its lit cathodes.
+    moder = 0x55550000U | 0x3FU;
+    led_scan_init(&scan, &charlieplex);
+    if ( 0x55550000U != scan.moder_base )
+    {
+        DEBUG_OUT("Error: the charlieplexed pins are not inputs!\r\n");
+        failed++;
+    }
+    led_scan_cell_write(&scan, LED_SCAN_CELL(0, 2, 3), 1);
+    led_scan_commit(&scan);
+    led_scan_isr(&scan);
+    if ( (0x55550000U | (1U << 0) | (1U << 4))   != moder ||
+         ((1U << 0) | (((1U << 1) | (1U << 2)) << 16)) != row_bsrr
+       )
+    {
+        printf("Error: anode 0 moder 0x%08x, bsrr 0x%08x\r\n",
+               moder, row_bsrr);
+        failed++;
+    }
+    if ( LED_OK == led_scan_cell_write(&scan, LED_SCAN_CELL(1, 1, 3), 1) )
+    {
+        DEBUG_OUT("Error: a led on the diagonal is accepted!\r\n");
+        failed++;
+    }
+
+    printf("Info: Test led scan failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led scan matrix ------------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the WS2812 encoder, no SPI is needed.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_ws2812 (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led ws2812 encoder ---------\r\n");
+    uint32_t           failed = 0;
+    uint32_t           code   = 0;
+    uint32_t           got    = 0;
+    uint8_t            stream[2 * LED_WS2812_BYTES_PER_PIXEL] = { 0 };
+    led_ws2812_pixel_t pixels[2] = { { 0x00, 0xFF, 0x00 },
+                                     { 0x00, 0x00, 0x00 } };
+    led_ws2812_pixel_t color     = { 255, 128, 1 };
+    /* 0x00 and 0xFF of green, then 0x00 of red and blue */
+    const uint8_t      expect[9] = { 0xDB, 0x6D, 0xB6, 0x92, 0x49, 0x24,
+                                     0x92, 0x49, 0x24 };
+
+    // case 1: the first pixel is sent as green, red and blue.
+    led_ws2812_encode(pixels, 1, stream);
+    for (uint32_t byte = 0; byte < LED_WS2812_BYTES_PER_PIXEL; byte++)
+    {
+        if ( expect[byte] != stream[byte] )
+        {
+            printf("Error: byte %d is 0x%02X not 0x%02X\r\n",
+                   byte, stream[byte], expect[byte]);
+            failed++;
+        }
+    }
+
+    // case 2: the table matches 100, 110 per bit for every value.
+    for (uint32_t value = 0; value < 256; value++)
+    {
+        code        = 0;
+        pixels[1].g = (uint8_t)value;
+        led_ws2812_encode(pixels, 2, stream);
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            code = (code << 3) | ((value & (0x80U >> bit)) ? 0x6U : 0x4U);
+        }
+        got = ((uint32_t)stream[9]  << 16) | ((uint32_t)stream[10] << 8) |
+               (uint32_t)stream[11];
+        if ( code != got )
+        {
+            printf("Error: 0x%02X is encoded as 0x%06X\r\n", value, got);
+            failed++;
+            break;
+        }
+    }
+
+    // case 3: the duty scales every channel with rounding.
+    color = led_ws2812_pixel_scale(&color, LED_DUTY_FULL / 2);
+    if ( 128 != color.r || 64 != color.g || 1 != color.b )
+    {
+        printf("Error: half of the color is %d %d %d\r\n",
+               color.r, color.g, color.b);
+        failed++;
+    }
+
+    printf("Info: Test led ws2812 failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led ws2812 encoder ---------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the image of a 74HC595 chain, no SPI is needed.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_shift (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led shift chain ------------\r\n");
+    uint32_t    failed    = 0;
+    uint8_t     image[3]  = { 0 };
+    uint8_t     stream[3] = { 0 };
+    led_shift_t chain;
+    /* Q0 of the first, Q1 of the second and Q7 of the last register */
+    const uint8_t expect[3] = { 0x80, 0x02, 0x01 };
+
+    // case 1: an output lands on its bit of the stream, the first 
+    //         register of the chain is the last byte.
+    led_shift_init(&chain, image, 3, 0);
+    led_shift_write(&chain,  0, 1);
+    led_shift_write(&chain,  9, 1);
+    led_shift_write(&chain, 23, 1);
+    led_shift_write(&chain,  5, 1);
+    led_shift_write(&chain,  5, 0);
+    if ( 1 != led_shift_commit(&chain, stream) )
+    {
+        DEBUG_OUT("Error: the changed image is not committed!\r\n");
+        failed++;
+    }
+    for (uint32_t reg = 0; reg < 3; reg++)
+    {
+        if ( expect[reg] != stream[reg] )
+        {
+            printf("Error: byte %d is 0x%02X not 0x%02X\r\n",
+                   reg, stream[reg], expect[reg]);
+            failed++;
+        }
+    }
+
+    // case 2: nothing is copied while no output changes.
+    if ( 0 != led_shift_commit(&chain, stream) )
+    {
+        DEBUG_OUT("Error: the image is copied without change!\r\n");
+        failed++;
+    }
+
+    // case 3: an output beyond the chain is refused.
+    if ( LED_ERRORPARAMETER != led_shift_write(&chain, 24, 1) )
+    {
+        DEBUG_OUT("Error: an output beyond the chain is written!\r\n");
+        failed++;
+    }
+
+    // case 4: an active low chain is dark at high level.
+    led_shift_init(&chain, image, 3, 1);
+    led_shift_write(&chain, 0, 1);
+    led_shift_commit(&chain, stream);
+    if ( 0xFF != stream[0] || 0xFE != stream[2] )
+    {
+        printf("Error: active low image is 0x%02X 0x%02X\r\n",
+               stream[0], stream[2]);
+        failed++;
+    }
+
+    printf("Info: Test led shift failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led shift chain ------------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the double buffered framebuffer of led outputs.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_frame (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led frame swap -------------\r\n");
+    uint32_t    failed = 0;
+    uint32_t    seq    = 0;
+    led_duty_t  duty[LED_FRAME_SLOT_NUM] = { 0 };
+    led_frame_t frame;
+
+    led_frame_init(&frame);
+
+    // case 1: a multi-led update is not seen before the swap.
+    led_frame_write(&frame, 0, LED_DUTY_FULL);
+    led_frame_write(&frame, 1, LED_DUTY_1_2);
+    led_frame_read(&frame, duty);
+    if ( 0 != duty[0] || 0 != duty[1] )
+    {
+        DEBUG_OUT("Error: the back frame is seen before the swap!\r\n");
+        failed++;
+    }
+
+    // case 2: the swap publishes every slot of the update at once.
+    led_frame_swap(&frame);
+    seq = led_frame_read(&frame, duty);
+    if ( LED_DUTY_FULL != duty[0] || LED_DUTY_1_2 != duty[1] || 1 != seq )
+    {
+        printf("Error: frame %d is 0x%x 0x%x\r\n", seq, duty[0], duty[1]);
+        failed++;
+    }
+
+    // case 3: the next tick composes on top of the published frame.
+    led_frame_write(&frame, 1, 0);
+    led_frame_swap(&frame);
+    if ( LED_DUTY_FULL != led_frame_duty_get(&frame, 0) ||
+         0             != led_frame_duty_get(&frame, 1)
+       )
+    {
+        DEBUG_OUT("Error: the slot not written lost its duty!\r\n");
+        failed++;
+    }
+
+    // case 4: nothing is published while no slot changes.
+    if ( 0 != led_frame_swap(&frame) || 2 != frame.seq )
+    {
+        DEBUG_OUT("Error: the frame is swapped without change!\r\n");
+        failed++;
+    }
+
+    printf("Info: Test led frame failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led frame swap -------------\r\n\r\n");
+    return failed;
+}
+/**
+ * @brief  Unit test for the drift of the blink engine, in virtual time.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_epoch (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led epoch deadlines ------\r\n");
+    uint32_t         failed    = 0;
+    uint32_t         edges     = 0;
+    uint32_t         errors    = 0;
+    uint32_t         next_us   = 0;
+    uint32_t         expect_us = 0;
+    uint32_t         now_us    = 0;
+    uint32_t         random    = 1;
+    led_duty_t       duty_last = LED_DUTY_FULL;
+    const uint32_t   base_us   = PATTERN_FAKE_BASE_US;
+    /* 10^6 edges of an odd cycle, the on time is rounded */
+    const uint32_t   cycle_us  = 997;
+    const uint32_t   cycles    = 500000;
+    bsp_led_driver_t led_fake;
+    __pattern_fake_init(&led_fake, &s_pattern_switch_ops);
+    led_fake.cycle_time_us = cycle_us;
+    led_fake.blink_times   = cycles;
+    led_fake.duty          = LED_DUTY_1_3;
+    led_fake.shape         = LED_WAVE_SQUARE;
+
+    // case 1: every edge of a long train is on the grid of its epoch,
+    //         ticked late by a random time below the shortest phase.
+    led_driver_blink_start(&led_fake, base_us);
+    now_us = base_us;
+    while ( LED_PHASE_IDLE != led_fake.blink_state.phase )
+    {
+        random  = random * 1664525U + 1013904223U;
+        now_us += 1 + (random >> 16) % led_fake.blink_state.on_time_us;
+        led_driver_blink_tick(&led_fake, now_us, &next_us);
+        if ( s_pattern_duty == duty_last )
+        {
+            continue;
+        }
+        duty_last = s_pattern_duty;
+        edges++;
+        // edge 0 is the start, edge 2n - 1 ends the on time of cycle
+        // n - 1 and edge 2n starts cycle n.
+        expect_us = base_us + ((edges + 1) / 2) * cycle_us;
+        if ( 0 == edges % 2 )
+        {
+            expect_us += led_fake.blink_state.on_time_us;
+        }
+        if ( LED_PHASE_IDLE != led_fake.blink_state.phase &&
+             expect_us      != next_us 
+           )
+        {
+            errors++;
+        }
+    }
+    if ( 2 * cycles - 1 != edges || 0 != errors ||
+         base_us + cycles * cycle_us != led_fake.blink_state.next_edge_us
+       )
+    {
+        printf("Error: %d edges, %d off the grid, end at %d us\r\n",
+               edges, errors, led_fake.blink_state.next_edge_us - base_us);
+        failed++;
+    }
+
+    // case 2: a hardware blink longer than the span of the time base
+    //         ends with its last cycle.
+    led_fake.p_led_opes  = &s_pattern_pwm_ops;
+    led_fake.blink_times =           3000000;
+    led_driver_blink_start(&led_fake, base_us);
+    while ( LED_PHASE_IDLE != led_fake.blink_state.phase )
+    {
+        led_driver_blink_tick(&led_fake, led_fake.blink_state.next_edge_us,
+                              &next_us);
+    }
+    if ( base_us + 3000000U * cycle_us != led_fake.blink_state.next_edge_us )
+    {
+        printf("Error: the hardware blink ends at %d us\r\n",
+               led_fake.blink_state.next_edge_us - base_us);
+        failed++;
+    }
+
+    // case 3: a newer command asks a hardware blink for its next cycle
+    //         start with a tick more than one cycle late.
+    led_driver_blink_start(&led_fake, base_us);
+    now_us = led_fake.blink_state.next_edge_us + 2 * cycle_us + cycle_us / 2;
+    led_driver_boundary_get(&led_fake, now_us, 1, &next_us);
+    if ( LED_TIME_BEFORE(next_us, now_us) || next_us - now_us > cycle_us ||
+         0 != (next_us - base_us) % cycle_us
+       )
+    {
+        printf("Error: the late boundary is %d us after the tick\r\n",
+               (int32_t)(next_us - now_us));
+        failed++;
+    }
+
+    printf("Info: Test led epoch failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led epoch deadlines ------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test and benchmark for the dither stage, only DWT is used.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_dither (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led dither stage -----------\r\n");
+    uint32_t       failed = 0;
+    uint32_t       cycles = 0;
+    uint32_t       sum    = 0;
+    uint32_t       lit    = 0;
+    led_dither_t   dither;
+    uint16_t       level[LED_DITHER_CHANNEL_NUM];
+    /* Frames of one whole pattern of the fraction */
+    const uint32_t frames = 1U << LED_DITHER_FRACTION_BITS;
+
+    led_dither_init(&dither, LED_DITHER_CHANNEL_NUM, LED_BAM_LEVEL_MAX);
+
+    // case 1: a whole level is shown as it is in every frame.
+    led_dither_duty_set(&dither, 0, (100U * LED_DUTY_FULL + 
+                                     LED_BAM_LEVEL_MAX / 2U) / 
+                                    LED_BAM_LEVEL_MAX);
+    for (uint32_t frame = 0; frame < frames; frame++)
+    {
+        led_dither_frame(&dither, level);
+        if ( 100 != level[0] )
+        {
+            printf("Error: frame %d of level 100 is %d\r\n", frame, level[0]);
+            failed++;
+            break;
+        }
+    }
+
+    // case 2: the mean of a fractional duty is kept over the pattern.
+    led_dither_duty_set(&dither, 1, 25765U);
+    sum = 0;
+    for (uint32_t frame = 0; frame < frames; frame++)
+    {
+        led_dither_frame(&dither, level);
+        sum += level[1];
+        if ( 100 != level[1] && 101 != level[1] )
+        {
+            printf("Error: frame %d of level 100.25 is %d\r\n", 
+                   frame, level[1]);
+            failed++;
+        }
+    }
+    if ( 401U * frames / 4U != sum )
+    {
+        printf("Error: the sum of level 100.25 is %d\r\n", sum);
+        failed++;
+    }
+
+    // case 3: a fraction of the lowest level is lit once per pattern.
+    led_dither_duty_set(&dither, 2, LED_DUTY_FULL / 
+                                    (LED_BAM_LEVEL_MAX * frames));
+    lit = 0;
+    for (uint32_t frame = 0; frame < 4U * frames; frame++)
+    {
+        led_dither_frame(&dither, level);
+        lit += level[2];
+    }
+    if ( 4U != lit )
+    {
+        printf("Error: 1/%d of level 1 is lit %d times\r\n", frames, lit);
+        failed++;
+    }
+
+    // case 4: cycles per led of one frame of all the leds.
+    for (uint32_t led = 0; led < LED_DITHER_CHANNEL_NUM; led++)
+    {
+        led_dither_duty_set(&dither, led, led * 2039U);
+    }
+    cycles = __bench_cycles_start();
+    led_dither_frame(&dither, level);
+    cycles = DWT->CYCCNT - cycles;
+    printf("Info: led_dither_frame costs %d cycles per led\r\n", 
+           cycles / LED_DITHER_CHANNEL_NUM);
+
+    printf("Info: Test led dither failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led dither stage -----------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test and benchmark for the layer stack, only DWT is used.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_layer (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led layer stack ------------\r\n");
+    uint32_t               failed = 0;
+    uint32_t               cycles = 0;
+    led_layer_stack_t      stack;
+    led_duty_t             duty[LED_LAYER_LED_NUM];
+    const led_blend_mode_t overlay[]  = { LED_BLEND_REPLACE, 
+                                          LED_BLEND_REPLACE  };
+    const led_blend_mode_t add[]      = { LED_BLEND_REPLACE, 
+                                          LED_BLEND_ADD      };
+    const led_blend_mode_t multiply[] = { LED_BLEND_REPLACE, 
+                                          LED_BLEND_MULTIPLY };
+    const led_blend_mode_t max[]      = { LED_BLEND_REPLACE, 
+                                          LED_BLEND_MAX      };
+    const led_blend_mode_t all[]      = { LED_BLEND_REPLACE,  LED_BLEND_ADD,
+                                          LED_BLEND_MAX,  LED_BLEND_MULTIPLY };
+
+    // case 1: an alert covers the status and the status shows again.
+    led_layer_stack_init(&stack, overlay, 2, 2);
+    led_layer_level_set(&stack, 0, 0, 0x4000);
+    led_layer_level_set(&stack, 0, 1, 0x2000);
+    led_layer_level_set(&stack, 1, 0, LED_LAYER_LEVEL_FULL);
+    led_layer_compose(&stack, duty);
+    if ( LED_DUTY_FULL != duty[0] || 0x4000U != duty[1] )
+    {
+        printf("Error: alert shows 0x%x 0x%x\r\n", duty[0], duty[1]);
+        failed++;
+    }
+    led_layer_clear(&stack, 1);
+    led_layer_compose(&stack, duty);
+    if ( 0x8000U != duty[0] || 0x4000U != duty[1] )
+    {
+        printf("Error: status after alert 0x%x 0x%x\r\n", duty[0], duty[1]);
+        failed++;
+    }
+
+    // case 2: nothing changed, nothing is blended.
+    if ( 0 != led_layer_compose(&stack, duty) )
+    {
+        DEBUG_OUT("Error: the stack is blended without a change!\r\n");
+        failed++;
+    }
+
+    // case 3: add saturates at full.
+    led_layer_stack_init(&stack, add, 2, 2);
+    led_layer_fill(&stack, 0, 0x6000);
+    led_layer_fill(&stack, 1, 0x6000);
+    led_layer_compose(&stack, duty);
+    if ( LED_DUTY_FULL != duty[0] )
+    {
+        printf("Error: add of 0x6000 twice is 0x%x\r\n", duty[0]);
+        failed++;
+    }
+
+    // case 4: a dimmer of half scales every led.
+    led_layer_stack_init(&stack, multiply, 2, 2);
+    led_layer_level_set(&stack, 0, 0, 0x4000);
+    led_layer_fill(&stack, 1, 0x4000);
+    led_layer_compose(&stack, duty);
+    if ( 0x4000U != duty[0] || 0 != duty[1] )
+    {
+        printf("Error: dimmed 0x%x 0x%x\r\n", duty[0], duty[1]);
+        failed++;
+    }
+    // a dimmer at full leaves every led as it is, also the one at full.
+    led_layer_level_set(&stack, 0, 0, 0x7FFE);
+    led_layer_level_set(&stack, 0, 1, LED_LAYER_LEVEL_FULL);
+    led_layer_fill(&stack, 1, LED_LAYER_LEVEL_FULL);
+    led_layer_compose(&stack, duty);
+    if ( 0xFFFCU != duty[0] || LED_DUTY_FULL != duty[1] )
+    {
+        printf("Error: dimmed at full 0x%x 0x%x\r\n", duty[0], duty[1]);
+        failed++;
+    }
+    // a led at full in the dimmer is left out of the scaling of the rest.
+    led_layer_level_set(&stack, 1, 1, 0x4000);
+    led_layer_compose(&stack, duty);
+    if ( 0xFFFCU != duty[0] || 0x7FFEU != duty[1] )
+    {
+        printf("Error: dimmed in part 0x%x 0x%x\r\n", duty[0], duty[1]);
+        failed++;
+    }
+
+    // case 5: max takes the brighter, a disabled layer is left out.
+    led_layer_stack_init(&stack, max, 2, 2);
+    led_layer_level_set(&stack, 0, 0, 0x1000);
+    led_layer_level_set(&stack, 1, 0, 0x3000);
+    led_layer_compose(&stack, duty);
+    if ( 0x6000U != duty[0] )
+    {
+        printf("Error: max of 0x1000 and 0x3000 is 0x%x\r\n", duty[0]);
+        failed++;
+    }
+    led_layer_enable(&stack, 1, 0);
+    led_layer_compose(&stack, duty);
+    if ( 0x2000U != duty[0] )
+    {
+        printf("Error: disabled max layer shows 0x%x\r\n", duty[0]);
+        failed++;
+    }
+
+    // case 6: cycles per led of one compose of four layers.
+    led_layer_stack_init(&stack, all, 4, LED_LAYER_LED_NUM);
+    for (uint32_t led = 0; led < LED_LAYER_LED_NUM; led++)
+    {
+        led_layer_level_set(&stack, 0, led, (q15_t)(led * 0x0700U));
+        led_layer_level_set(&stack, 1, led, 0x0400);
+        led_layer_level_set(&stack, 2, led, (q15_t)(0x7000U - led * 0x0700U));
+    }
+    led_layer_fill(&stack, 3, 0x6000);
+    cycles = __bench_cycles_start();
+    led_layer_compose(&stack, duty);
+    cycles = DWT->CYCCNT - cycles;
+    printf("Info: led_layer_compose costs %d cycles per led\r\n", 
+           cycles / LED_LAYER_LED_NUM);
+
+    printf("Info: Test led layer failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led layer stack ------------\r\n\r\n");
+    return failed;
+}
+
+/**
+ * @brief  Unit test for the keyframe timelines, in virtual time.
+ * @param  None
+ * @retval 0 if all cases pass, else the number of failed cases.
+ */
+uint32_t Test_led_timeline (void)
+{
+    DEBUG_OUT("Begin: ----------- Test led keyframe timeline -----\r\n");
+    uint32_t         failed  = 0;
+    uint32_t         frames  = 0;
+    uint32_t         next_us = 0;
+    uint32_t         now_us  = 0;
+    const uint32_t   base_us = PATTERN_FAKE_BASE_US;
+    bsp_led_driver_t led_fake;
+    __pattern_fake_init(&led_fake, &s_pattern_pwm_ops);
+
+    // case 1: the seek finds the last keyframe at or before the position.
+    if ( 0 != led_timeline_seek(&led_timeline_heartbeat,    0) ||
+         0 != led_timeline_seek(&led_timeline_heartbeat,   99) ||
+         1 != led_timeline_seek(&led_timeline_heartbeat,  100) ||
+         4 != led_timeline_seek(&led_timeline_heartbeat, 1199) ||
+         5 != led_timeline_seek(&led_timeline_heartbeat, 9999)
+       )
+    {
+        DEBUG_OUT("Error: the seek of the heartbeat is wrong!\r\n");
+        failed++;
+    }
+
+    // case 2: the duty is linear between two keyframes.
+    if ( LED_DUTY_FULL / 2U != 
+         led_timeline_sample(&led_timeline_heartbeat, 0, 50) ||
+         4608U != led_timeline_sample(&led_timeline_sunrise, 1, 30000)
+       )
+    {
+        DEBUG_OUT("Error: the duty between two keyframes is wrong!\r\n");
+        failed++;
+    }
+
+    // case 3: the sunrise is played to its end, one frame per deadline.
+    led_timeline_start(&led_fake, &led_timeline_sunrise, 0, base_us);
+    now_us = led_fake.blink_state.next_edge_us;
+    frames = 0;
+    while ( LED_PHASE_IDLE != led_fake.blink_state.phase )
+    {
+        led_driver_blink_tick(&led_fake, now_us, &next_us);
+        frames++;
+        if ( (uint32_t)(base_us + 30000U * LED_US_PER_MS) == now_us &&
+             4608U != s_pattern_duty
+           )
+        {
+            printf("Error: sunrise at 30s is 0x%x\r\n", s_pattern_duty);
+            failed++;
+        }
+        now_us = next_us;
+    }
+    if ( LED_DUTY_FULL != s_pattern_duty                    ||
+         60000U / LED_WAVE_FRAME_MS != frames               ||
+         (uint32_t)(base_us + 60000U * LED_US_PER_MS) != 
+                                    led_fake.blink_state.next_edge_us
+       )
+    {
+        printf("Error: sunrise ends at 0x%x after %d frames\r\n", 
+               s_pattern_duty, frames);
+        failed++;
+    }
+
+    // case 4: a start in the middle seeks, it does not replay the start.
+    led_timeline_start(&led_fake, &led_timeline_sunrise, 30000, base_us);
+    if ( 4608U != s_pattern_duty || 1 != led_fake.blink_state.timeline_key )
+    {
+        printf("Error: sunrise from 30s starts at 0x%x\r\n", s_pattern_duty);
+        failed++;
+    }
+
+    // case 5: a flat part of the heartbeat costs no frame.
+    led_timeline_start(&led_fake, &led_timeline_heartbeat, 500, base_us);
+    if ( 0 != s_pattern_duty || 
+         (uint32_t)(base_us + 700U * LED_US_PER_MS) != 
+                                    led_fake.blink_state.next_edge_us
+       )
+    {
+        DEBUG_OUT("Error: the rest of the heartbeat is ticked!\r\n");
+        failed++;
+    }
+
+    // case 6: a pause holds the duty and a resume plays on from there.
+    led_timeline_start(&led_fake, &led_timeline_heartbeat, 0, base_us);
+    now_us = base_us;
+    while ( LED_TIME_BEFORE(now_us, 
+                            (uint32_t)(base_us + 1250U * LED_US_PER_MS)) )
+    {
+        led_driver_blink_tick(&led_fake, now_us, &next_us);
+        now_us = next_us;
+    }
+    led_driver_blink_cancel(&led_fake, now_us);
+    led_timeline_pause(&led_fake);
+    if ( LED_DUTY_FULL / 2U != s_pattern_duty ||
+         50 != led_fake.blink_state.timeline_pos_ms
+       )
+    {
+        printf("Error: heartbeat paused at %dms shows 0x%x\r\n",
+               led_fake.blink_state.timeline_pos_ms, s_pattern_duty);
+        failed++;
+    }
+    led_timeline_start(&led_fake, &led_timeline_heartbeat, 
+                       LED_TIMELINE_RESUME, now_us + 5000000U);
+    if ( LED_DUTY_FULL / 2U != s_pattern_duty ||
+         LED_PHASE_TIMELINE != led_fake.blink_state.phase
+       )
+    {
+        printf("Error: heartbeat resumed at 0x%x\r\n", s_pattern_duty);
+        failed++;
+    }
+
+    printf("Info: Test led timeline failed cases = %d\r\n", failed);
+    DEBUG_OUT("End  : ----------- Test led keyframe timeline -----\r\n\r\n");
+    return failed;
+}
 //******************************** Defines **********************************//
\ No newline at end of file
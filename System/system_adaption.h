@@ -8,6 +8,21 @@
  * @par dependencies
  * - bsp_led_driver.h
  * - bsp_led_handler.h
+ * - bsp_led_gamma.h
+ * - bsp_led_wave.h
+ * - bsp_led_pattern.h
+ * - bsp_led_timeline.h
+ * - bsp_led_port.h
+ * - system_led_pwm.h
+ * - system_led_bsrr_dma.h
+ * - system_led_gpio.h
+ * - system_time_base.h
+ * - system_led_bam.h
+ * - system_led_scan.h
+ * - system_led_ws2812.h
+ * - system_led_shift.h
+ * - system_led_frame.h
+ * - system_led_layer.h
  *
  * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
  *
@@ -36,6 +51,21 @@
 
 #include "bsp_led_driver.h"
 #include "bsp_led_handler.h"
+#include "bsp_led_gamma.h"
+#include "bsp_led_wave.h"
+#include "bsp_led_pattern.h"
+#include "bsp_led_timeline.h"
+#include "bsp_led_port.h"
+#include "system_led_pwm.h"
+#include "system_led_bsrr_dma.h"
+#include "system_led_gpio.h"
+#include "system_time_base.h"
+#include "system_led_bam.h"
+#include "system_led_scan.h"
+#include "system_led_ws2812.h"
+#include "system_led_shift.h"
+#include "system_led_frame.h"
+#include "system_led_layer.h"
 //******************************** Includes *********************************//
 
 //******************************** Defines **********************************//
@@ -219,8 +249,8 @@ led_handler_status_t os_queue_get_handler  (
                                 )
        )
     {
-        DEBUG_OUT("Error: Receive queue failed!\r\n");
-        ret = HANDLER_ERRORRESOURCE;
+        /* Empty queue is the normal way to wake up on a deadline */
+        ret = HANDLER_ERRORTIMEOUT;
     }
 
     return ret;
@@ -382,9 +412,43 @@ led_handler_status_t get_time_base_ms (uint32_t *const time_stamp)
 
     return ret;
 }
+
+led_handler_status_t get_time_base_us (uint32_t *const time_stamp)
+{
+    led_handler_status_t ret = HANDLER_OK;
+
+    if ( NULL == time_stamp )
+    {
+        DEBUG_OUT("Error: Parameter error!\r\n");
+        ret = HANDLER_ERRORPARAMETER;
+        return ret;
+    }
+
+    *time_stamp = system_time_base_us();
+
+    return ret;
+}
+
+led_handler_status_t get_time_base_mm (uint32_t *const time_stamp)
+{
+    led_handler_status_t ret = HANDLER_OK;
+
+    if ( NULL == time_stamp )
+    {
+        DEBUG_OUT("Error: Parameter error!\r\n");
+        ret = HANDLER_ERRORPARAMETER;
+        return ret;
+    }
+
+    *time_stamp = system_time_base_mm();
+
+    return ret;
+}
 handler_time_base_t time_base_handler = 
 {
+    .pf_get_time_base_us = get_time_base_us,
     .pf_get_time_base_ms = get_time_base_ms,
+    .pf_get_time_base_mm = get_time_base_mm,
 };
 /**************unit test for led handler -- end*************/
 
@@ -0,0 +1,278 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_bam.c
+ *
+ * @par dependencies
+ * - system_led_bam.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief bit-angle modulation backend of led_operations_t on one timer.
+ *
+ * Processing flow:
+ *
+ * The update interrupt of the timer shows the bitplane of one bit and 
+ * sets ARR to the weight of that bit, so a frame costs LED_BAM_BITS 
+ * interrupts however many leds are driven.
+ *
+ * With LED_BAM_DITHER the requests only set the targets of the dither
+ * stage, one word each. The ISR of the last bit, the longest one, runs
+ * the dither frame and commits the levels, so the ISR is the only writer
+ * of the bitplanes and no critical section of the threads is needed.
+ *
+ * @version V1.0 2025-05-30
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_bam.h"
+#include "FreeRTOS.h"
+#include "task.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* The GPIO of every port of the engine                                    */
+static GPIO_TypeDef *const led_bam_gpio_ports[LED_BAM_PORT_NUM] = 
+{
+    GPIOA, GPIOB, GPIOC,
+};
+
+/* The leds, PB0-PB15, PC0-PC12 and PA6-PA8, all on at high level          */
+static const led_bam_channel_t led_bam_channels[] = 
+{
+    { 1, 0, GPIO_PIN_0  }, { 1, 0, GPIO_PIN_1  }, { 1, 0, GPIO_PIN_2  },
+    { 1, 0, GPIO_PIN_3  }, { 1, 0, GPIO_PIN_4  }, { 1, 0, GPIO_PIN_5  },
+    { 1, 0, GPIO_PIN_6  }, { 1, 0, GPIO_PIN_7  }, { 1, 0, GPIO_PIN_8  },
+    { 1, 0, GPIO_PIN_9  }, { 1, 0, GPIO_PIN_10 }, { 1, 0, GPIO_PIN_11 },
+    { 1, 0, GPIO_PIN_12 }, { 1, 0, GPIO_PIN_13 }, { 1, 0, GPIO_PIN_14 },
+    { 1, 0, GPIO_PIN_15 },
+    { 2, 0, GPIO_PIN_0  }, { 2, 0, GPIO_PIN_1  }, { 2, 0, GPIO_PIN_2  },
+    { 2, 0, GPIO_PIN_3  }, { 2, 0, GPIO_PIN_4  }, { 2, 0, GPIO_PIN_5  },
+    { 2, 0, GPIO_PIN_6  }, { 2, 0, GPIO_PIN_7  }, { 2, 0, GPIO_PIN_8  },
+    { 2, 0, GPIO_PIN_9  }, { 2, 0, GPIO_PIN_10 }, { 2, 0, GPIO_PIN_11 },
+    { 2, 0, GPIO_PIN_12 },
+    { 0, 0, GPIO_PIN_6  }, { 0, 0, GPIO_PIN_7  }, { 0, 0, GPIO_PIN_8  },
+};
+
+static TIM_HandleTypeDef htim_led_bam;
+static led_bam_t         led_bam;
+#if LED_BAM_DITHER
+static led_dither_t      led_bam_dither;
+static uint16_t          led_bam_dither_levels[LED_DITHER_CHANNEL_NUM];
+
+/**
+ * @brief build the bitplanes of the next frame from the dither stage.
+ */
+static void __led_bam_dither_frame(void)
+{
+    led_dither_frame(&led_bam_dither, led_bam_dither_levels);
+    for (uint32_t channel = 0; channel < led_bam.channel_num; channel++)
+    {
+        led_bam_level_set(&led_bam, channel, 
+                          led_bam_dither_levels[channel]);
+    }
+    led_bam_commit(&led_bam);
+}
+#endif
+
+/**
+ * @brief This function handles TIM3 global interrupt.
+ */
+void TIM3_IRQHandler(void)
+{
+    uint32_t weight = 0;
+
+    if ( 0 == (LED_BAM_TIM->SR & TIM_SR_UIF) )
+    {
+        return;
+    }
+    LED_BAM_TIM->SR = ~TIM_SR_UIF;
+
+    // ARR is not preloaded and the counter has just restarted, so the new
+    // value already ends the bit being shown.
+    weight           = led_bam_isr(&led_bam);
+    LED_BAM_TIM->ARR = weight * LED_BAM_BASE_US - 1U;
+
+#if LED_BAM_DITHER
+    // the last bit lasts half a frame, the next frame is swapped in after.
+    if ( (1U << (LED_BAM_BITS - 1U)) == weight )
+    {
+        __led_bam_dither_frame();
+    }
+#endif
+}
+
+/**
+ * @brief  request the level of a channel, it is shown after the flush.
+ * @param[in] channel : Index of the led in the channel table.
+ * @param[in] level   : Level of the led, up to LED_BAM_LEVEL_MAX.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_bam_level_set(
+                            const uint32_t                       channel,
+                            const uint32_t                         level
+                                     )
+{
+    led_status_t ret = LED_OK;
+
+#if LED_BAM_DITHER
+    if ( level > LED_BAM_LEVEL_MAX )
+    {
+        DEBUG_OUT("Error: system_led_bam_level_set Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    ret = led_dither_duty_set(&led_bam_dither, channel,
+                              (level * LED_DUTY_FULL + 
+                               LED_BAM_LEVEL_MAX / 2U) / LED_BAM_LEVEL_MAX);
+#else
+    taskENTER_CRITICAL();
+    ret = led_bam_level_set(&led_bam, channel, level);
+    taskEXIT_CRITICAL();
+#endif
+
+    return ret;
+}
+
+/**
+ * @brief  request the duty of a channel, rounded to the nearest level, or
+ *         dithered over the frames with LED_BAM_DITHER.
+ * @param[in] channel : Index of the led in the channel table.
+ * @param[in] duty    : Duty[Q16 of LED_DUTY_FULL].
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_bam_duty_set(
+                            const uint32_t                       channel,
+                            const uint32_t                          duty
+                                    )
+{
+    if ( duty > LED_DUTY_FULL )
+    {
+        DEBUG_OUT("Error: system_led_bam_duty_set Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+#if LED_BAM_DITHER
+    return led_dither_duty_set(&led_bam_dither, channel, duty);
+#else
+    return system_led_bam_level_set(channel,
+                                    (duty * LED_BAM_LEVEL_MAX + 
+                                     LED_DUTY_FULL / 2U) / LED_DUTY_FULL);
+#endif
+}
+
+/**
+ * @brief  build the bitplanes of the levels requested since the last call.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_bam_flush(void)
+{
+#if !LED_BAM_DITHER
+    taskENTER_CRITICAL();
+    led_bam_commit(&led_bam);
+    taskEXIT_CRITICAL();
+#endif
+
+    return LED_OK;
+}
+
+SYSTEM_LED_BAM_OPS_DEFINE(led_bam_ch0_ops, 0);
+SYSTEM_LED_BAM_OPS_DEFINE(led_bam_ch1_ops, 1);
+
+/**
+ * @brief init the pins of the channels and start the timer, every led is
+ *        off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bam_init(void)
+{
+    GPIO_InitTypeDef   gpio_init  = { 0 };
+    volatile uint32_t *p_bsrr[LED_BAM_PORT_NUM];
+    uint32_t           pins[LED_BAM_PORT_NUM] = { 0 };
+    uint32_t           channel_num = sizeof(led_bam_channels) / 
+                                     sizeof(led_bam_channels[0]);
+    uint32_t           tim_clock   = HAL_RCC_GetPCLK1Freq();
+    led_status_t       ret         = LED_OK;
+
+    DEBUG_OUT("Info: Enter system_led_bam_init!\r\n");
+
+    /* APB1 timers run at twice PCLK1 when APB1 is divided */
+    if ( RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE1) )
+    {
+        tim_clock *= 2U;
+    }
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_TIM3_CLK_ENABLE();
+
+    /*********************1.the pins of the leds***************************/
+    for (uint32_t channel = 0; channel < channel_num; channel++)
+    {
+        pins[led_bam_channels[channel].port] |= 
+                                    led_bam_channels[channel].pin_mask;
+    }
+    for (uint32_t port = 0; port < LED_BAM_PORT_NUM; port++)
+    {
+        p_bsrr[port] = &(led_bam_gpio_ports[port]->BSRR);
+        if ( 0 == pins[port] )
+        {
+            continue;
+        }
+        HAL_GPIO_WritePin(led_bam_gpio_ports[port], pins[port], 
+                          GPIO_PIN_RESET);
+        gpio_init.Pin   =                pins[port];
+        gpio_init.Mode  =       GPIO_MODE_OUTPUT_PP;
+        gpio_init.Pull  =               GPIO_NOPULL;
+        gpio_init.Speed =       GPIO_SPEED_FREQ_LOW;
+        HAL_GPIO_Init(led_bam_gpio_ports[port], &gpio_init);
+    }
+
+    ret = led_bam_init(&led_bam, p_bsrr, led_bam_channels, channel_num);
+    if ( LED_OK != ret )
+    {
+        return ret;
+    }
+#if LED_BAM_DITHER
+    ret = led_dither_init(&led_bam_dither, channel_num, LED_BAM_LEVEL_MAX);
+    if ( LED_OK != ret )
+    {
+        return ret;
+    }
+#endif
+
+    /*********************2.the timer of the bitplanes*********************/
+    htim_led_bam.Instance               =                        LED_BAM_TIM;
+    htim_led_bam.Init.Prescaler         = tim_clock / LED_BAM_COUNTER_HZ - 1U;
+    htim_led_bam.Init.CounterMode       =                 TIM_COUNTERMODE_UP;
+    htim_led_bam.Init.Period            =            LED_BAM_BASE_US - 1U;
+    htim_led_bam.Init.ClockDivision     =             TIM_CLOCKDIVISION_DIV1;
+    htim_led_bam.Init.AutoReloadPreload =    TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if ( HAL_OK != HAL_TIM_Base_Init(&htim_led_bam) )
+    {
+        DEBUG_OUT("Error: Init led bam timer failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    HAL_NVIC_SetPriority(LED_BAM_TIM_IRQn, LED_BAM_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LED_BAM_TIM_IRQn);
+
+    if ( HAL_OK != HAL_TIM_Base_Start_IT(&htim_led_bam) )
+    {
+        DEBUG_OUT("Error: Start led bam timer failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    return LED_OK;
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_bam.h
+ *
+ * @par dependencies
+ * - main.h
+ * - bsp_led_driver.h
+ * - bsp_led_bam.h
+ * - bsp_led_dither.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief bit-angle modulation backend of led_operations_t on one timer.
+ *
+ * Processing flow:
+ *
+ * system_led_bam_init() -> mount the ops of SYSTEM_LED_BAM_OPS_DEFINE
+ * to a bsp_led_driver_t, the handler commits the levels once per tick,
+ * and TIM3 shows one bitplane per interrupt. With LED_BAM_DITHER the
+ * duties go to a dither stage instead, and TIM3 builds the bitplanes of
+ * the next frame itself while the last bit is shown.
+ *
+ * @version V1.0 2025-05-30
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_BAM_H__
+#define __SYSTEM_LED_BAM_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+
+#include "bsp_led_driver.h"
+#include "bsp_led_bam.h"
+#include "bsp_led_dither.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define LED_BAM_TIM                  TIM3
+#define LED_BAM_TIM_IRQn             TIM3_IRQn
+/* No OS API is called in the ISR, it is above the kernel mask, so no 
+   critical section of the threads stretches a bit                        */
+#define LED_BAM_IRQ_PRIORITY         (4U)
+/* Counter clock of the timer, 1 tick == 1 us                              */
+#define LED_BAM_COUNTER_HZ           (1000000U)
+/* Period[us] of bit 0, a frame is LED_BAM_LEVEL_MAX of them, so 4.08 ms
+   or 245 Hz at 8 bits                                                    */
+#define LED_BAM_BASE_US              (16U)
+/* Non-zero to spread the fraction of a duty over the frames, the 8 bits
+   of a frame then give LED_DITHER_FRACTION_BITS more bits of brightness  */
+#ifndef LED_BAM_DITHER
+#define LED_BAM_DITHER               (1U)
+#endif
+
+/* Define the led operations of one channel of the bam engine              */
+#define SYSTEM_LED_BAM_OPS_DEFINE(name, channel)                              \
+    static led_status_t name##_on (void)                                      \
+    {                                                                         \
+        return system_led_bam_level_set((channel), LED_BAM_LEVEL_MAX);        \
+    }                                                                         \
+    static led_status_t name##_off (void)                                     \
+    {                                                                         \
+        return system_led_bam_level_set((channel), 0);                        \
+    }                                                                         \
+    static led_status_t name##_set_duty (const uint32_t duty)                 \
+    {                                                                         \
+        return system_led_bam_duty_set((channel), duty);                      \
+    }                                                                         \
+    led_operations_t name =                                                   \
+    {                                                                         \
+        .pf_led_on         =             name##_on,                           \
+        .pf_led_off        =            name##_off,                           \
+        .pf_led_set_duty   =       name##_set_duty,                           \
+        .pf_led_flush      =  system_led_bam_flush,                           \
+    }
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations of the first two channels, PB0 and PB1               */
+extern led_operations_t led_bam_ch0_ops;
+extern led_operations_t led_bam_ch1_ops;
+
+/**
+ * @brief request the level of a channel, it is shown after the flush.
+ *
+ * @param[in] channel     : Index of the led in the channel table.
+ * @param[in] level       : Level of the led, up to LED_BAM_LEVEL_MAX.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bam_level_set(
+                            const uint32_t                       channel,
+                            const uint32_t                         level
+                                     );
+
+/**
+ * @brief request the duty of a channel, rounded to the nearest level, or
+ *        dithered over the frames with LED_BAM_DITHER.
+ *
+ * @param[in] channel     : Index of the led in the channel table.
+ * @param[in] duty        : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bam_duty_set(
+                            const uint32_t                       channel,
+                            const uint32_t                          duty
+                                    );
+
+/**
+ * @brief build the bitplanes of the levels requested since the last call,
+ *        nothing to do with LED_BAM_DITHER, the ISR builds them.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bam_flush(void);
+
+/**
+ * @brief init the pins of the channels and start the timer, every led is
+ *        off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bam_init(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_BAM_H__
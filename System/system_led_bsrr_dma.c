@@ -0,0 +1,638 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_bsrr_dma.c
+ *
+ * @par dependencies
+ * - system_led_bsrr_dma.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief DMA playback of rendered BSRR words to one GPIO port.
+ *
+ * Processing flow:
+ *
+ * system_led_bsrr_init() -> system_led_bsrr_play() renders the first ring
+ * and starts the DMA on the update of LED_BSRR_TIM -> __led_bsrr_half_cplt()
+ * and __led_bsrr_cplt() refill the half just played -> system_led_bsrr_stop()
+ * once every pin keeps one level, or when called by the user.
+ *
+ * The pins driven as leds request their duty, period and count, then
+ * system_led_bsrr_flush() puts them in the tracks from a guard after the
+ * sample being played and re-renders the ring ahead of the DMA.
+ *
+ * @version V1.0 2025-05-12
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_bsrr_dma.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+static TIM_HandleTypeDef  htim_led_bsrr;
+static DMA_HandleTypeDef  hdma_led_bsrr;
+static GPIO_TypeDef      *p_led_bsrr_port = NULL;
+static uint32_t           led_bsrr_ring[LED_BSRR_RING_SAMPLES];
+static led_render_track_t led_bsrr_tracks[LED_RENDER_TRACK_NUM];
+static uint32_t           led_bsrr_track_num     = 0;
+/* Sample index of the next half to be rendered                            */
+static uint32_t           led_bsrr_render_sample = 0;
+/* Sample index after which every track has ended                          */
+static uint32_t           led_bsrr_end_sample    = 0;
+/* Non-zero if a track blinks for ever, the stream never stops by itself   */
+static uint32_t           led_bsrr_is_endless    = 0;
+static volatile uint32_t  led_bsrr_is_playing    = 0;
+
+/* Total samples of a track which plays for ever                           */
+#define LED_BSRR_FOREVER_SAMPLES     (0x7FFFFFFFU)
+/* Position after which a track which plays for ever is moved on           */
+#define LED_BSRR_REBASE_SAMPLES      (0x40000000U)
+#define LED_BSRR_PIN_NUM             (16U)
+
+typedef struct
+{
+    /* Duty[Q16 of LED_DUTY_FULL] requested for the pin */
+    uint32_t                                       duty;
+    /* Period[us] requested, 0 before the first one     */
+    uint32_t                                  period_us;
+    /* Cycles to play, 0 for ever                       */
+    uint32_t                                     cycles;
+    /* Non-zero if the led is on at the low level       */
+    uint32_t                              is_active_low;
+} led_bsrr_pin_t;
+
+static led_bsrr_pin_t     led_bsrr_pins[LED_BSRR_PIN_NUM];
+/* Pins requested since the last flush                                     */
+static uint32_t           led_bsrr_dirty_mask    = 0;
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/**
+ * @brief  find the sample after which every pin keeps one level, a track
+ *         which is on or off for ever keeps it from its start.
+ */
+static void __led_bsrr_end_calc(void)
+{
+    const led_render_track_t *p_track = NULL;
+    uint32_t                  settle  = 0;
+
+    led_bsrr_is_endless = 0;
+    led_bsrr_end_sample = led_bsrr_render_sample - LED_BSRR_RING_SAMPLES;
+    for ( uint32_t track_number = 0; 
+          track_number < led_bsrr_track_num; ++ track_number )
+    {
+        p_track = &(led_bsrr_tracks[track_number]);
+        if ( 0 == p_track->pin_mask )
+        {
+            continue;
+        }
+        settle = p_track->start_sample + p_track->total_samples;
+        if ( LED_BSRR_FOREVER_SAMPLES == p_track->total_samples )
+        {
+            if ( 0 != p_track->on_samples &&
+                 p_track->on_samples < p_track->cycle_samples )
+            {
+                led_bsrr_is_endless = 1;
+            }
+            settle = p_track->start_sample;
+        }
+        if ( (int32_t)(settle - led_bsrr_end_sample) > 0 )
+        {
+            led_bsrr_end_sample = settle;
+        }
+    }
+}
+
+/**
+ * @brief  the sample being played, from the counter of the DMA.
+ * @retval Sample index.
+ */
+static uint32_t __led_bsrr_play_sample(void)
+{
+    uint32_t first = led_bsrr_render_sample - LED_BSRR_RING_SAMPLES;
+    uint32_t index = LED_BSRR_RING_SAMPLES - 
+                     __HAL_DMA_GET_COUNTER(&hdma_led_bsrr);
+
+    return first + (index - first) % LED_BSRR_RING_SAMPLES;
+}
+
+/**
+ * @brief  re-render the samples from first_sample up to the end of the ring.
+ * @param[in] first_sample : The first sample to be re-rendered.
+ */
+static void __led_bsrr_render_ahead(uint32_t first_sample)
+{
+    uint32_t index = 0;
+    uint32_t num   = 0;
+
+    while ( (int32_t)(led_bsrr_render_sample - first_sample) > 0 )
+    {
+        index = first_sample % LED_BSRR_RING_SAMPLES;
+        num   = LED_BSRR_RING_SAMPLES - index;
+        if ( num > led_bsrr_render_sample - first_sample )
+        {
+            num = led_bsrr_render_sample - first_sample;
+        }
+        led_render_bsrr(led_bsrr_tracks,
+                        led_bsrr_track_num,
+                        first_sample,
+                        &led_bsrr_ring[index],
+                        num);
+        first_sample += num;
+    }
+}
+
+/**
+ * @brief  render the whole ring from sample 0 and start the DMA.
+ * @retval LED_OK if success.
+ */
+static led_status_t __led_bsrr_start(void)
+{
+    // 1. pre-render the whole ring before the first trigger.
+    led_bsrr_render_sample = 0;
+    __led_bsrr_end_calc();
+    led_render_bsrr(led_bsrr_tracks,
+                    led_bsrr_track_num,
+                    0,
+                    led_bsrr_ring,
+                    LED_BSRR_RING_SAMPLES);
+    led_bsrr_render_sample = LED_BSRR_RING_SAMPLES;
+
+    // 2. one word per update event of the timer, the first one a whole
+    //    sample after the restart of the counter.
+    htim_led_bsrr.Instance->EGR = TIM_EGR_UG;
+    if ( HAL_OK != HAL_DMA_Start_IT(&hdma_led_bsrr,
+                                    (uint32_t)led_bsrr_ring,
+                                    (uint32_t)&(p_led_bsrr_port->BSRR),
+                                    LED_BSRR_RING_SAMPLES) )
+    {
+        DEBUG_OUT("Error: Start led bsrr dma failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+    led_bsrr_is_playing = 1;
+    __HAL_TIM_ENABLE_DMA(&htim_led_bsrr, TIM_DMA_UPDATE);
+
+    return LED_OK;
+}
+
+/**
+ * @brief  refill one half of the ring, stop once the tail has been played.
+ * @param[in] p_half : The half of the ring which has just been played.
+ */
+static void __led_bsrr_refill(uint32_t *const p_half)
+{
+    led_render_track_t *p_track  = NULL;
+    uint32_t            position = 0;
+
+    if ( 0 == led_bsrr_is_endless &&
+         (int32_t)(led_bsrr_render_sample - led_bsrr_end_sample) >= 
+         (int32_t)LED_BSRR_RING_SAMPLES
+       )
+    {
+        // the pins keep the levels played last, the tracks are done.
+        system_led_bsrr_stop();
+        led_bsrr_track_num = 0;
+        return;
+    }
+
+    // a track which plays for ever is moved on by whole cycles, so its
+    // position never reaches the end of its samples.
+    for ( uint32_t track_number = 0; 
+          track_number < led_bsrr_track_num; ++ track_number )
+    {
+        p_track  = &(led_bsrr_tracks[track_number]);
+        position = led_bsrr_render_sample - p_track->start_sample;
+        if ( LED_BSRR_FOREVER_SAMPLES == p_track->total_samples &&
+             0 != p_track->pin_mask                             &&
+             (int32_t)position >= (int32_t)LED_BSRR_REBASE_SAMPLES )
+        {
+            p_track->start_sample += position - 
+                                     position % p_track->cycle_samples;
+        }
+    }
+
+    led_render_bsrr(led_bsrr_tracks,
+                    led_bsrr_track_num,
+                    led_bsrr_render_sample,
+                    p_half,
+                    LED_BSRR_RING_SAMPLES / 2U);
+    led_bsrr_render_sample += LED_BSRR_RING_SAMPLES / 2U;
+}
+
+static void __led_bsrr_half_cplt(DMA_HandleTypeDef *hdma)
+{
+    __led_bsrr_refill(&led_bsrr_ring[0]);
+}
+
+static void __led_bsrr_cplt(DMA_HandleTypeDef *hdma)
+{
+    __led_bsrr_refill(&led_bsrr_ring[LED_BSRR_RING_SAMPLES / 2U]);
+}
+
+/**
+ * @brief This function handles DMA2 stream5 global interrupt.
+ */
+void DMA2_Stream5_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_led_bsrr);
+}
+
+/**
+ * @brief init the DMA stream which writes the BSRR of the port, and the
+ *        timer which paces it.
+ *
+ * @param[in] p_port : The GPIO port whose pins are already outputs.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_init(GPIO_TypeDef *const p_port)
+{
+    uint32_t tim_clock = HAL_RCC_GetPCLK2Freq();
+
+    DEBUG_OUT("Info: Enter system_led_bsrr_init!\r\n");
+
+    if ( NULL == p_port )
+    {
+        DEBUG_OUT("Error: system_led_bsrr_init Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+    p_led_bsrr_port = p_port;
+
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    hdma_led_bsrr.Instance                 =       LED_BSRR_DMA_STREAM;
+    hdma_led_bsrr.Init.Channel             =      LED_BSRR_DMA_CHANNEL;
+    hdma_led_bsrr.Init.Direction           =   DMA_MEMORY_TO_PERIPH;
+    hdma_led_bsrr.Init.PeriphInc           =      DMA_PINC_DISABLE;
+    hdma_led_bsrr.Init.MemInc              =       DMA_MINC_ENABLE;
+    hdma_led_bsrr.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma_led_bsrr.Init.MemDataAlignment    = DMA_MDATAALIGN_WORD;
+    hdma_led_bsrr.Init.Mode                =         DMA_CIRCULAR;
+    hdma_led_bsrr.Init.Priority            =   DMA_PRIORITY_HIGH;
+    hdma_led_bsrr.Init.FIFOMode            =  DMA_FIFOMODE_DISABLE;
+    if ( HAL_OK != HAL_DMA_Init(&hdma_led_bsrr) )
+    {
+        DEBUG_OUT("Error: Init led bsrr dma failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    hdma_led_bsrr.XferHalfCpltCallback = __led_bsrr_half_cplt;
+    hdma_led_bsrr.XferCpltCallback     =      __led_bsrr_cplt;
+
+    HAL_NVIC_SetPriority(LED_BSRR_DMA_IRQn, LED_BSRR_DMA_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LED_BSRR_DMA_IRQn);
+
+    /* APB2 timers run at twice PCLK2 when APB2 is divided */
+    if ( RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE2) )
+    {
+        tim_clock *= 2U;
+    }
+
+    __HAL_RCC_TIM1_CLK_ENABLE();
+
+    // the counter runs free, only its update request is switched by play.
+    htim_led_bsrr.Instance               =                      LED_BSRR_TIM;
+    htim_led_bsrr.Init.Prescaler         = tim_clock / LED_BSRR_COUNTER_HZ
+                                                                      - 1U;
+    htim_led_bsrr.Init.CounterMode       =                TIM_COUNTERMODE_UP;
+    htim_led_bsrr.Init.Period            =         LED_RENDER_SAMPLE_US - 1U;
+    htim_led_bsrr.Init.ClockDivision     =            TIM_CLOCKDIVISION_DIV1;
+    htim_led_bsrr.Init.AutoReloadPreload =    TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if ( HAL_OK != HAL_TIM_Base_Init(&htim_led_bsrr) )
+    {
+        DEBUG_OUT("Error: Init led bsrr timer failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+    if ( HAL_OK != HAL_TIM_Base_Start(&htim_led_bsrr) )
+    {
+        DEBUG_OUT("Error: Start led bsrr timer failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    return LED_OK;
+}
+
+/**
+ * @brief render the events and start the playback from now on.
+ *
+ * @param[in] p_events    : The events, one per led of the port.
+ * @param[in] p_pin_masks : Pin mask of the led of each event.
+ * @param[in] event_num   : Number of events, up to LED_RENDER_TRACK_NUM.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_play(
+                            const led_event_t *const    p_events,
+                            const uint16_t    *const p_pin_masks,
+                            const uint32_t             event_num
+                                 )
+{
+    led_status_t ret = LED_OK;
+
+    if ( NULL == p_events || NULL == p_pin_masks   ||
+         0    == event_num|| LED_RENDER_TRACK_NUM < event_num ||
+         NULL == p_led_bsrr_port
+       )
+    {
+        DEBUG_OUT("Error: system_led_bsrr_play Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    // the old transfer and its refills are over before the ring is rewritten.
+    system_led_bsrr_stop();
+
+    // 1. convert the events into the tracks of the port.
+    led_bsrr_track_num = 0;
+    for ( uint32_t event_number = 0; event_number < event_num; ++event_number)
+    {
+        ret = led_render_track_init(&led_bsrr_tracks[event_number],
+                                    &p_events[event_number],
+                                    p_pin_masks[event_number],
+                                    0);
+        if ( LED_OK != ret )
+        {
+            return ret;
+        }
+    }
+    led_bsrr_track_num = event_num;
+
+    // 2. render the ring and start the DMA.
+    return __led_bsrr_start();
+}
+
+/**
+ * @brief stop the playback, the pins keep their current level.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_stop(void)
+{
+    __HAL_TIM_DISABLE_DMA(&htim_led_bsrr, TIM_DMA_UPDATE);
+    led_bsrr_is_playing = 0;
+    // the blocking abort waits for the stream to be disabled, clears its
+    // flags and leaves it READY, so a replay can start at once. A refill
+    // raised by the old transfer must not run over the new ring either.
+    HAL_DMA_Abort(&hdma_led_bsrr);
+    HAL_NVIC_ClearPendingIRQ(LED_BSRR_DMA_IRQn);
+
+    return LED_OK;
+}
+
+/**
+ * @brief  the number of a pin from its mask.
+ * @param[in] pin_mask : The pin, GPIO_PIN_x.
+ * @retval The number of the pin, LED_BSRR_PIN_NUM if the mask is not one pin.
+ */
+static uint32_t __led_bsrr_pin_number(const uint16_t pin_mask)
+{
+    for ( uint32_t pin = 0; pin < LED_BSRR_PIN_NUM; ++ pin )
+    {
+        if ( (1U << pin) == pin_mask )
+        {
+            return pin;
+        }
+    }
+
+    return LED_BSRR_PIN_NUM;
+}
+
+/**
+ * @brief request the duty of a pin, a count of cycles is dropped. It is
+ *        played after the flush.
+ *
+ * @param[in] pin_mask      : The pin of the led, GPIO_PIN_x.
+ * @param[in] is_active_low : Non-zero if the led is on at the low level.
+ * @param[in] duty          : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_duty_set(
+                            const uint16_t                      pin_mask,
+                            const uint32_t                 is_active_low,
+                            const uint32_t                          duty
+                                     )
+{
+    uint32_t pin = __led_bsrr_pin_number(pin_mask);
+
+    if ( LED_BSRR_PIN_NUM == pin || duty > LED_DUTY_FULL )
+    {
+        DEBUG_OUT("Error: system_led_bsrr_duty_set Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    led_bsrr_pins[pin].duty          =          duty;
+    led_bsrr_pins[pin].cycles        =             0;
+    led_bsrr_pins[pin].is_active_low = is_active_low;
+    led_bsrr_dirty_mask             |=      pin_mask;
+
+    return LED_OK;
+}
+
+/**
+ * @brief request the period of a pin, its cycle restarts at the flush.
+ *
+ * @param[in] pin_mask    : The pin of the led, GPIO_PIN_x.
+ * @param[in] period_us   : Period[us], rounded to LED_RENDER_SAMPLE_US.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_period_set(
+                            const uint16_t                      pin_mask,
+                            const uint32_t                     period_us
+                                       )
+{
+    uint32_t pin = __led_bsrr_pin_number(pin_mask);
+
+    if ( LED_BSRR_PIN_NUM == pin || 0 == period_us )
+    {
+        DEBUG_OUT("Error: system_led_bsrr_period_set Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    led_bsrr_pins[pin].period_us  = period_us;
+    led_bsrr_dirty_mask          |=  pin_mask;
+
+    return LED_OK;
+}
+
+/**
+ * @brief request a pin to turn off after a number of cycles, the first
+ *        one starts at the flush.
+ *
+ * @param[in] pin_mask    : The pin of the led, GPIO_PIN_x.
+ * @param[in] cycles      : Number of cycles.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_count_set(
+                            const uint16_t                      pin_mask,
+                            const uint32_t                        cycles
+                                      )
+{
+    uint32_t pin = __led_bsrr_pin_number(pin_mask);
+
+    if ( LED_BSRR_PIN_NUM == pin || 0 == cycles )
+    {
+        DEBUG_OUT("Error: system_led_bsrr_count_set Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    led_bsrr_pins[pin].cycles  =   cycles;
+    led_bsrr_dirty_mask       |= pin_mask;
+
+    return LED_OK;
+}
+
+/**
+ * @brief  put the request of a pin in its track, from start_sample on.
+ * @param[in] pin          : The number of the pin.
+ * @param[in] start_sample : Sample index at which the request is played.
+ * @retval LED_OK if success.
+ */
+static led_status_t __led_bsrr_pin_track_set(
+                            const uint32_t                           pin,
+                            const uint32_t                  start_sample
+                                            )
+{
+    led_status_t          ret           = LED_OK;
+    const led_bsrr_pin_t *p_pin         = &(led_bsrr_pins[pin]);
+    led_render_track_t   *p_track       = NULL;
+    uint32_t              period_us     = p_pin->period_us;
+    uint32_t              cycle_samples = 0;
+    led_event_t           event         = { 0 };
+
+    // 1. the track of the pin, or a free one.
+    for ( uint32_t track_number = 0; 
+          track_number < led_bsrr_track_num; ++ track_number )
+    {
+        if ( (1U << pin) == led_bsrr_tracks[track_number].pin_mask )
+        {
+            p_track = &(led_bsrr_tracks[track_number]);
+            break;
+        }
+        if ( NULL == p_track && 0 == led_bsrr_tracks[track_number].pin_mask )
+        {
+            p_track = &(led_bsrr_tracks[track_number]);
+        }
+    }
+    if ( NULL == p_track && led_bsrr_track_num < LED_RENDER_TRACK_NUM )
+    {
+        p_track = &(led_bsrr_tracks[led_bsrr_track_num++]);
+    }
+    if ( NULL == p_track )
+    {
+        DEBUG_OUT("Error: No track is left for the led bsrr pin!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    // 2. the period is rounded to whole samples.
+    if ( 0 == period_us )
+    {
+        period_us = LED_BSRR_DEFAULT_PERIOD_US;
+    }
+    cycle_samples = (period_us + LED_RENDER_SAMPLE_US / 2U) / 
+                                                   LED_RENDER_SAMPLE_US;
+    if ( 0 == cycle_samples )
+    {
+        cycle_samples = 1;
+    }
+    event.cycle_time_us = cycle_samples * LED_RENDER_SAMPLE_US;
+    event.blink_times   =                                    1;
+    event.duty          =                (led_duty_t)p_pin->duty;
+    event.shape         =                      LED_WAVE_SQUARE;
+    ret = led_render_track_init(p_track, &event, 
+                                (uint16_t)(1U << pin), start_sample);
+    if ( LED_OK != ret )
+    {
+        return ret;
+    }
+
+    // 3. a count too long for the samples plays for ever, the driver ends
+    //    the command at its deadline anyway.
+    p_track->is_active_low = p_pin->is_active_low;
+    p_track->total_samples = LED_BSRR_FOREVER_SAMPLES;
+    if ( 0 != p_pin->cycles && 
+         p_pin->cycles < LED_BSRR_FOREVER_SAMPLES / cycle_samples )
+    {
+        p_track->total_samples = p_pin->cycles * cycle_samples;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief play the requests of the pins from a guard after the sample being
+ *        played, the stream is started if it is idle.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_flush(void)
+{
+    led_status_t ret   = LED_OK;
+    uint32_t     start = 0;
+
+    if ( 0 == led_bsrr_dirty_mask )
+    {
+        return ret;
+    }
+    if ( NULL == p_led_bsrr_port )
+    {
+        DEBUG_OUT("Error: system_led_bsrr_flush is called before init!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    // 1. the refills must not run while the tracks and the ring change, an
+    //    idle stream restarts from sample 0 with the requested pins only.
+    HAL_NVIC_DisableIRQ(LED_BSRR_DMA_IRQn);
+    if ( 0 != led_bsrr_is_playing )
+    {
+        start = __led_bsrr_play_sample() + LED_BSRR_GUARD_SAMPLES;
+    }
+    else
+    {
+        led_bsrr_track_num = 0;
+    }
+
+    // 2. one track per requested pin.
+    for ( uint32_t pin = 0; pin < LED_BSRR_PIN_NUM; ++ pin )
+    {
+        if ( 0 != (led_bsrr_dirty_mask & (1U << pin)) &&
+             LED_OK != __led_bsrr_pin_track_set(pin, start) )
+        {
+            ret = LED_ERRORRESOURCE;
+        }
+    }
+    led_bsrr_dirty_mask = 0;
+
+    // 3. re-render what the DMA has not played yet, or start it.
+    if ( 0 != led_bsrr_is_playing )
+    {
+        __led_bsrr_end_calc();
+        __led_bsrr_render_ahead(start);
+    }
+    else if ( LED_OK != __led_bsrr_start() )
+    {
+        ret = LED_ERRORRESOURCE;
+    }
+    HAL_NVIC_EnableIRQ(LED_BSRR_DMA_IRQn);
+
+    return ret;
+}
+
+SYSTEM_LED_BSRR_OPS_DEFINE(led_blue_bsrr_ops, LED_BLUE_Pin, 1);
+//******************************** Declaring ********************************//
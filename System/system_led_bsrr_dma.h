@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_bsrr_dma.h
+ *
+ * @par dependencies
+ * - main.h
+ * - bsp_led_render.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief DMA playback of rendered BSRR words to one GPIO port.
+ *
+ * Processing flow:
+ *
+ * system_led_bsrr_init() -> system_led_bsrr_play() -> half/full transfer
+ * callbacks refill the ring -> stops by itself after the last edge.
+ *
+ * A pin may also be a led of the handler: SYSTEM_LED_BSRR_OPS_DEFINE gives
+ * it a duty-cycle backend with a cycle counter, so the driver offloads its
+ * blinks, dimming and waves to the stream. The pins only request a track,
+ * system_led_bsrr_flush() re-renders the ring ahead of the DMA once per
+ * engine tick, and the stream stops when every pin keeps one level.
+ *
+ * The DMA is triggered by the update event of TIM1, one sample every
+ * LED_RENDER_SAMPLE_US. DMA2 is used because only its peripheral port
+ * reaches the GPIO on AHB1, and TIM1 is the only timer of the F411 which
+ * requests DMA2, so the HAL time base runs on TIM11.
+ *
+ * @version V1.0 2025-05-12
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_BSRR_DMA_H__
+#define __SYSTEM_LED_BSRR_DMA_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+
+#include "bsp_led_render.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* The timer of the samples, it counts in us                               */
+#define LED_BSRR_TIM                 TIM1
+#define LED_BSRR_COUNTER_HZ          (1000000U)
+/* TIM1_UP request is mapped to DMA2 stream 5 channel 6                     */
+#define LED_BSRR_DMA_STREAM          DMA2_Stream5
+#define LED_BSRR_DMA_CHANNEL         DMA_CHANNEL_6
+#define LED_BSRR_DMA_IRQn            DMA2_Stream5_IRQn
+/* No OS API is called in the callbacks, so it may preempt the kernel     */
+#define LED_BSRR_DMA_IRQ_PRIORITY    (5U)
+/* Samples in the ring, each half is refilled while the other is played,
+   a power of 2 so the sample being played is found from the DMA counter  */
+#define LED_BSRR_RING_SAMPLES        (256U)
+/* Samples between the one being played and the first one re-rendered     */
+#define LED_BSRR_GUARD_SAMPLES       (32U)
+/* Period[us] of a pin before its first pf_led_set_period                 */
+#define LED_BSRR_DEFAULT_PERIOD_US   (LED_DIM_PERIOD_US)
+/* The blue led on PC13 is played by the stream, 0 keeps the GPIO shadow   */
+#define LED_BSRR_BLUE                (1U)
+
+/* Define the led operations of one pin of the port of the stream          */
+#define SYSTEM_LED_BSRR_OPS_DEFINE(name, pin, active_low)                     \
+    static led_status_t name##_on (void)                                      \
+    {                                                                         \
+        return system_led_bsrr_duty_set((pin), (active_low), LED_DUTY_FULL);  \
+    }                                                                         \
+    static led_status_t name##_off (void)                                     \
+    {                                                                         \
+        return system_led_bsrr_duty_set((pin), (active_low), 0);              \
+    }                                                                         \
+    static led_status_t name##_set_duty (const uint32_t duty)                 \
+    {                                                                         \
+        return system_led_bsrr_duty_set((pin), (active_low), duty);           \
+    }                                                                         \
+    static led_status_t name##_set_period (const uint32_t period_us)          \
+    {                                                                         \
+        return system_led_bsrr_period_set((pin), period_us);                  \
+    }                                                                         \
+    static led_status_t name##_set_count (const uint32_t cycles)              \
+    {                                                                         \
+        return system_led_bsrr_count_set((pin), cycles);                      \
+    }                                                                         \
+    led_operations_t name =                                                   \
+    {                                                                         \
+        .pf_led_on         =             name##_on,                           \
+        .pf_led_off        =            name##_off,                           \
+        .pf_led_set_duty   =       name##_set_duty,                           \
+        .pf_led_set_period =     name##_set_period,                           \
+        .pf_led_flush      = system_led_bsrr_flush,                           \
+        .pf_led_set_count  =      name##_set_count,                           \
+    }
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations of the blue led on PC13, it is on at low level       */
+extern led_operations_t led_blue_bsrr_ops;
+
+/**
+ * @brief init the DMA stream which writes the BSRR of the port, and the
+ *        timer which paces it.
+ *
+ * @param[in] p_port : The GPIO port whose pins are already outputs.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_init(GPIO_TypeDef *const p_port);
+
+/**
+ * @brief render the events and start the playback from now on, the tracks
+ *        of the pins driven as leds are dropped.
+ *
+ * @param[in] p_events    : The events, one per led of the port.
+ * @param[in] p_pin_masks : Pin mask of the led of each event.
+ * @param[in] event_num   : Number of events, up to LED_RENDER_TRACK_NUM.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_play(
+                            const led_event_t *const    p_events,
+                            const uint16_t    *const p_pin_masks,
+                            const uint32_t             event_num
+                                 );
+
+/**
+ * @brief stop the playback, the pins keep their current level.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_stop(void);
+
+/**
+ * @brief request the duty of a pin, a count of cycles is dropped. It is
+ *        played after the flush.
+ *
+ * @param[in] pin_mask      : The pin of the led, GPIO_PIN_x.
+ * @param[in] is_active_low : Non-zero if the led is on at the low level.
+ * @param[in] duty          : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_duty_set(
+                            const uint16_t                      pin_mask,
+                            const uint32_t                 is_active_low,
+                            const uint32_t                          duty
+                                     );
+
+/**
+ * @brief request the period of a pin, its cycle restarts at the flush.
+ *
+ * @param[in] pin_mask    : The pin of the led, GPIO_PIN_x.
+ * @param[in] period_us   : Period[us], rounded to LED_RENDER_SAMPLE_US.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_period_set(
+                            const uint16_t                      pin_mask,
+                            const uint32_t                     period_us
+                                       );
+
+/**
+ * @brief request a pin to turn off after a number of cycles, the first
+ *        one starts at the flush.
+ *
+ * @param[in] pin_mask    : The pin of the led, GPIO_PIN_x.
+ * @param[in] cycles      : Number of cycles.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_count_set(
+                            const uint16_t                      pin_mask,
+                            const uint32_t                        cycles
+                                      );
+
+/**
+ * @brief play the requests of the pins from a guard after the sample being
+ *        played, the stream is started if it is idle.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_bsrr_flush(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_BSRR_DMA_H__
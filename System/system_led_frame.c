@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_frame.c
+ *
+ * @par dependencies
+ * - system_led_frame.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief framebuffer backend of led_operations_t, published per tick.
+ *
+ * Processing flow:
+ *
+ * No critical section is taken, the writes and the swap come from the 
+ * one worker which owns the leds, and the readers retry on a swap.
+ *
+ * @version V1.0 2025-06-08
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_frame.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+static led_frame_t led_frame;
+
+/**
+ * @brief  compose the duty of a slot, it is published by the flush.
+ * @param[in] slot : Index of the slot.
+ * @param[in] duty : Duty[Q16 of LED_DUTY_FULL].
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_frame_write(
+                            const uint32_t                          slot,
+                            const uint32_t                          duty
+                                   )
+{
+    return led_frame_write(&led_frame, slot, duty);
+}
+
+/**
+ * @brief  publish the slots composed since the last call in one swap.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_frame_flush(void)
+{
+    led_frame_swap(&led_frame);
+
+    return LED_OK;
+}
+
+/**
+ * @brief  copy the published frame, from any context.
+ * @param[out] p_duty : The duties, LED_FRAME_SLOT_NUM entries.
+ * @retval The sequence of the swap which published the copy.
+ */
+uint32_t system_led_frame_read(led_duty_t *const p_duty)
+{
+    return led_frame_read(&led_frame, p_duty);
+}
+
+SYSTEM_LED_FRAME_OPS_DEFINE(led_frame_slot0_ops, 0);
+SYSTEM_LED_FRAME_OPS_DEFINE(led_frame_slot1_ops, 1);
+
+/**
+ * @brief init the framebuffer, every slot is off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_frame_init(void)
+{
+    DEBUG_OUT("Info: Enter system_led_frame_init!\r\n");
+
+    return led_frame_init(&led_frame);
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_frame.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ * - bsp_led_frame.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief framebuffer backend of led_operations_t, published per tick.
+ *
+ * Processing flow:
+ *
+ * system_led_frame_init() -> mount the ops of SYSTEM_LED_FRAME_OPS_DEFINE
+ * to a bsp_led_driver_t per slot, the engine composes the tick into the 
+ * back frame and its flush swaps it -> readers, e.g. an ISR or a status
+ * task, call system_led_frame_read() without a critical section.
+ *
+ * The handler dispatches every led of the framebuffer to one worker, as
+ * they share the flush, so the back frame has a single producer.
+ *
+ * @version V1.0 2025-06-08
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_FRAME_H__
+#define __SYSTEM_LED_FRAME_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include "bsp_led_frame.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Define the led operations of one slot of the framebuffer                */
+#define SYSTEM_LED_FRAME_OPS_DEFINE(name, slot)                               \
+    static led_status_t name##_on (void)                                      \
+    {                                                                         \
+        return system_led_frame_write((slot), LED_DUTY_FULL);                 \
+    }                                                                         \
+    static led_status_t name##_off (void)                                     \
+    {                                                                         \
+        return system_led_frame_write((slot), 0);                             \
+    }                                                                         \
+    static led_status_t name##_set_duty (const uint32_t duty)                 \
+    {                                                                         \
+        return system_led_frame_write((slot), duty);                          \
+    }                                                                         \
+    led_operations_t name =                                                   \
+    {                                                                         \
+        .pf_led_on         =             name##_on,                           \
+        .pf_led_off        =            name##_off,                           \
+        .pf_led_set_duty   =       name##_set_duty,                           \
+        .pf_led_flush      = system_led_frame_flush,                          \
+    }
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations of the first two slots                               */
+extern led_operations_t led_frame_slot0_ops;
+extern led_operations_t led_frame_slot1_ops;
+
+/**
+ * @brief compose the duty of a slot, it is published by the flush.
+ *
+ * @param[in] slot        : Index of the slot.
+ * @param[in] duty        : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_frame_write(
+                            const uint32_t                          slot,
+                            const uint32_t                          duty
+                                   );
+
+/**
+ * @brief publish the slots composed since the last call in one swap.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_frame_flush(void);
+
+/**
+ * @brief copy the published frame, from any context.
+ *
+ * @param[out] p_duty      : The duties, LED_FRAME_SLOT_NUM entries.
+ *
+ * @return uint32_t : The sequence of the swap which published the copy.
+ *
+ * */
+uint32_t system_led_frame_read(led_duty_t *const p_duty);
+
+/**
+ * @brief init the framebuffer, every slot is off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_frame_init(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_FRAME_H__
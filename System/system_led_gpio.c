@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_gpio.c
+ *
+ * @par dependencies
+ * - system_led_gpio.h
+ * - FreeRTOS.h
+ * - task.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief GPIO backend of led_operations_t with one shadow per port.
+ *
+ * Processing flow:
+ *
+ * The leds of one port may be owned by different workers, so the shadow
+ * is only touched in a critical section of a few instructions.
+ *
+ * @version V1.0 2025-05-26
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_gpio.h"
+#include "FreeRTOS.h"
+#include "task.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* The GPIO of every shadowed port                                         */
+static GPIO_TypeDef *const led_gpio_ports[LED_GPIO_PORT_NUM] = 
+{
+    GPIOA, GPIOB, GPIOC,
+};
+static led_port_t          led_gpio_shadow[LED_GPIO_PORT_NUM];
+
+/**
+ * @brief  request the level of pins in the shadow of the port.
+ * @param[in] port     : The shadowed port of the pins.
+ * @param[in] pin_mask : Pins to be written, GPIO_PIN_x.
+ * @param[in] is_high  : Non-zero to set the pins, zero to reset them.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_gpio_write(
+                            const led_gpio_port_t                   port,
+                            const uint32_t                      pin_mask,
+                            const uint32_t                       is_high
+                                  )
+{
+    if ( port >= LED_GPIO_PORT_NUM )
+    {
+        DEBUG_OUT("Error: system_led_gpio_write Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    taskENTER_CRITICAL();
+    led_port_pin_write(&led_gpio_shadow[port], pin_mask, is_high);
+    taskEXIT_CRITICAL();
+
+    return LED_OK;
+}
+
+/**
+ * @brief  store the pins changed since the last call.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_gpio_flush(void)
+{
+    taskENTER_CRITICAL();
+    led_port_flush(led_gpio_shadow, LED_GPIO_PORT_NUM);
+    taskEXIT_CRITICAL();
+
+    return LED_OK;
+}
+
+SYSTEM_LED_GPIO_OPS_DEFINE(led_blue_ops, LED_GPIO_PORT_C, LED_BLUE_Pin, 1);
+
+/**
+ * @brief init the shadows with the level of the ports, the pins of the 
+ *        leds are already outputs.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_gpio_init(void)
+{
+    led_status_t ret = LED_OK;
+    DEBUG_OUT("Info: Enter system_led_gpio_init!\r\n");
+
+    for (uint32_t port = 0; port < LED_GPIO_PORT_NUM && LED_OK == ret; port++)
+    {
+        ret = led_port_init(&led_gpio_shadow[port],
+                            &(led_gpio_ports[port]->BSRR),
+                            led_gpio_ports[port]->ODR);
+    }
+
+    return ret;
+}
+//******************************** Defines **********************************//
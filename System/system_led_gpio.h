@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_gpio.h
+ *
+ * @par dependencies
+ * - main.h
+ * - bsp_led_driver.h
+ * - bsp_led_port.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief GPIO backend of led_operations_t with one shadow per port.
+ *
+ * Processing flow:
+ *
+ * system_led_gpio_init() -> mount the ops of SYSTEM_LED_GPIO_OPS_DEFINE
+ * to a bsp_led_driver_t, the handler flushes the ports once per tick.
+ *
+ * @version V1.0 2025-05-26
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_GPIO_H__
+#define __SYSTEM_LED_GPIO_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+
+#include "bsp_led_driver.h"
+#include "bsp_led_port.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+typedef enum
+{
+    LED_GPIO_PORT_A       =    0,   /* GPIOA                                 */
+    LED_GPIO_PORT_B       =    1,   /* GPIOB                                 */
+    LED_GPIO_PORT_C       =    2,   /* GPIOC                                 */
+    LED_GPIO_PORT_NUM            ,  /* Number of the shadowed ports          */
+} led_gpio_port_t;
+
+/* Define the led operations of one pin, its level is stored by the flush   */
+#define SYSTEM_LED_GPIO_OPS_DEFINE(name, port, pin, active_low)               \
+    static led_status_t name##_on (void)                                      \
+    {                                                                         \
+        return system_led_gpio_write((port), (pin), !(active_low));           \
+    }                                                                         \
+    static led_status_t name##_off (void)                                     \
+    {                                                                         \
+        return system_led_gpio_write((port), (pin),  (active_low));           \
+    }                                                                         \
+    led_operations_t name =                                                   \
+    {                                                                         \
+        .pf_led_on         =             name##_on,                           \
+        .pf_led_off        =            name##_off,                           \
+        .pf_led_flush      = system_led_gpio_flush,                           \
+    }
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations of the blue led on PC13, it is on at low level       */
+extern led_operations_t led_blue_ops;
+
+/**
+ * @brief request the level of pins in the shadow of the port.
+ *
+ * @param[in] port        : The shadowed port of the pins.
+ * @param[in] pin_mask    : Pins to be written, GPIO_PIN_x.
+ * @param[in] is_high     : Non-zero to set the pins, zero to reset them.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_gpio_write(
+                            const led_gpio_port_t                   port,
+                            const uint32_t                      pin_mask,
+                            const uint32_t                       is_high
+                                  );
+
+/**
+ * @brief store the pins changed since the last call, one BSRR word per 
+ *        port at most.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_gpio_flush(void);
+
+/**
+ * @brief init the shadows with the level of the ports, the pins of the 
+ *        leds are already outputs.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_gpio_init(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_GPIO_H__
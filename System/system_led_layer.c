@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_layer.c
+ *
+ * @par dependencies
+ * - system_led_layer.h
+ * - system_led_bam.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief layered backend of led_operations_t, composited onto real leds.
+ *
+ * Processing flow:
+ *
+ * The flush blends the stack only if a layer changed, and writes every
+ * real led by its own ops, so any backend can show the stack.
+ *
+ * @version V1.0 2025-06-20
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_layer.h"
+#include "system_led_bam.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Blend mode of every layer, the bottom one first                         */
+static const led_blend_mode_t led_layer_modes[] =
+{
+    [LED_LAYER_STATUS] = LED_BLEND_REPLACE ,
+    [LED_LAYER_ALERT]  = LED_BLEND_REPLACE ,
+    [LED_LAYER_DIMMER] = LED_BLEND_MULTIPLY,
+};
+
+/* The real leds which show the stack, one per led of the layers           */
+static led_operations_t *const led_layer_outputs[] =
+{
+    &led_bam_ch0_ops, &led_bam_ch1_ops,
+};
+
+#define LED_LAYER_OUTPUT_NUM                                                  \
+    (sizeof(led_layer_outputs) / sizeof(led_layer_outputs[0]))
+
+static led_layer_stack_t led_layer_stack;
+
+/**
+ * @brief  convert a duty to the level of a layer.
+ * @param[in] duty : Duty[Q16 of LED_DUTY_FULL].
+ * @retval The level[Q15].
+ */
+static q15_t __led_layer_level(const uint32_t duty)
+{
+    return (duty >= LED_DUTY_FULL) ? LED_LAYER_LEVEL_FULL :
+                                     (q15_t)(duty >> 1);
+}
+
+/**
+ * @brief  set the duty of one led in one layer, it is shown by the flush.
+ * @param[in] layer : Index of the layer.
+ * @param[in] led   : Index of the led.
+ * @param[in] duty  : Duty[Q16 of LED_DUTY_FULL].
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_layer_write(
+                            const uint32_t                         layer,
+                            const uint32_t                           led,
+                            const uint32_t                          duty
+                                   )
+{
+    return led_layer_level_set(&led_layer_stack, layer, led,
+                               __led_layer_level(duty));
+}
+
+/**
+ * @brief  set the duty of every led in one layer, e.g. the dimmer.
+ * @param[in] layer : Index of the layer.
+ * @param[in] duty  : Duty[Q16 of LED_DUTY_FULL].
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_layer_fill(
+                            const uint32_t                         layer,
+                            const uint32_t                          duty
+                                  )
+{
+    return led_layer_fill(&led_layer_stack, layer, __led_layer_level(duty));
+}
+
+/**
+ * @brief  clear one layer, the layers below show through after the flush.
+ * @param[in] layer : Index of the layer.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_layer_clear(const uint32_t layer)
+{
+    return led_layer_clear(&led_layer_stack, layer);
+}
+
+/**
+ * @brief  blend the layers and write the duties to the real leds.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_layer_flush(void)
+{
+    led_status_t ret                        = LED_OK;
+    led_duty_t   duty[LED_LAYER_OUTPUT_NUM] = { 0 };
+
+    if ( 0 == led_layer_compose(&led_layer_stack, duty) )
+    {
+        return ret;
+    }
+
+    for (uint32_t led = 0; led < LED_LAYER_OUTPUT_NUM; led++)
+    {
+        ret = led_layer_outputs[led]->pf_led_set_duty(duty[led]);
+        if ( LED_OK != ret )
+        {
+            return ret;
+        }
+        if ( NULL != led_layer_outputs[led]->pf_led_flush )
+        {
+            led_layer_outputs[led]->pf_led_flush();
+        }
+    }
+
+    return ret;
+}
+
+SYSTEM_LED_LAYER_OPS_DEFINE(led_layer_status0_ops, LED_LAYER_STATUS, 0);
+SYSTEM_LED_LAYER_OPS_DEFINE(led_layer_alert0_ops , LED_LAYER_ALERT , 0);
+
+/**
+ * @brief init the stack, every layer is clear and the real leds are off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_layer_init(void)
+{
+    led_status_t ret = LED_OK;
+
+    DEBUG_OUT("Info: Enter system_led_layer_init!\r\n");
+
+    ret = led_layer_stack_init(&led_layer_stack, led_layer_modes,
+                               sizeof(led_layer_modes) /
+                               sizeof(led_layer_modes[0]),
+                               LED_LAYER_OUTPUT_NUM);
+    if ( LED_OK != ret )
+    {
+        return ret;
+    }
+
+    // the dimmer starts at full, the stack shows the status as it is.
+    return system_led_layer_flush();
+}
+//******************************** Defines **********************************//
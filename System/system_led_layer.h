@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_layer.h
+ *
+ * @par dependencies
+ * - bsp_led_driver.h
+ * - bsp_led_layer.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief layered backend of led_operations_t, composited onto real leds.
+ *
+ * Processing flow:
+ *
+ * system_led_layer_init() -> mount the ops of SYSTEM_LED_LAYER_OPS_DEFINE
+ * to a bsp_led_driver_t per layer and led, each runs its own effect into
+ * its layer -> the flush blends the stack and writes the duties to the
+ * ops of the real leds.
+ *
+ * e.g. the status pattern runs on the STATUS layer, an alert blinks on the
+ * ALERT layer and system_led_layer_clear() ends it, the status pattern has
+ * run on underneath and shows again. system_led_layer_fill() sets the
+ * DIMMER of every led at once.
+ *
+ * The handler dispatches every led of the stack to one worker, as they
+ * share the flush, so the layers have a single producer.
+ *
+ * @version V1.0 2025-06-20
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_LAYER_H__
+#define __SYSTEM_LED_LAYER_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_led_driver.h"
+#include "bsp_led_layer.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* Layers of the stack, the bottom one first                               */
+#define LED_LAYER_STATUS             (0U)
+#define LED_LAYER_ALERT              (1U)
+#define LED_LAYER_DIMMER             (2U)
+
+/* Define the led operations of one led in one layer of the stack          */
+#define SYSTEM_LED_LAYER_OPS_DEFINE(name, layer, led)                         \
+    static led_status_t name##_on (void)                                      \
+    {                                                                         \
+        return system_led_layer_write((layer), (led), LED_DUTY_FULL);         \
+    }                                                                         \
+    static led_status_t name##_off (void)                                     \
+    {                                                                         \
+        return system_led_layer_write((layer), (led), 0);                     \
+    }                                                                         \
+    static led_status_t name##_set_duty (const uint32_t duty)                 \
+    {                                                                         \
+        return system_led_layer_write((layer), (led), duty);                  \
+    }                                                                         \
+    led_operations_t name =                                                   \
+    {                                                                         \
+        .pf_led_on         =             name##_on,                           \
+        .pf_led_off        =            name##_off,                           \
+        .pf_led_set_duty   =       name##_set_duty,                           \
+        .pf_led_flush      = system_led_layer_flush,                          \
+    }
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations of led 0 in the status and in the alert layer        */
+extern led_operations_t led_layer_status0_ops;
+extern led_operations_t led_layer_alert0_ops;
+
+/**
+ * @brief set the duty of one led in one layer, it is shown by the flush.
+ *
+ * @param[in] layer       : Index of the layer.
+ * @param[in] led         : Index of the led.
+ * @param[in] duty        : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_layer_write(
+                            const uint32_t                         layer,
+                            const uint32_t                           led,
+                            const uint32_t                          duty
+                                   );
+
+/**
+ * @brief set the duty of every led in one layer, e.g. the dimmer.
+ *
+ * @param[in] layer       : Index of the layer.
+ * @param[in] duty        : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_layer_fill(
+                            const uint32_t                         layer,
+                            const uint32_t                          duty
+                                  );
+
+/**
+ * @brief clear one layer, the layers below show through after the flush.
+ *
+ * @param[in] layer       : Index of the layer.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_layer_clear(const uint32_t layer);
+
+/**
+ * @brief blend the layers and write the duties to the real leds.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_layer_flush(void);
+
+/**
+ * @brief init the stack, every layer is clear and the real leds are off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_layer_init(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_LAYER_H__
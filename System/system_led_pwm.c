@@ -0,0 +1,241 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_pwm.c
+ *
+ * @par dependencies
+ * - system_led_pwm.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief timer PWM backend of led_operations_t.
+ *
+ * Processing flow:
+ *
+ * The period is set by ARR and the duty by CCR, both are preloaded, so 
+ * the CPU does nothing between two changes. A counted blink takes one 
+ * update IRQ per cycle, never one per edge, and the IRQ writes the off
+ * level into CCR at the start of the last cycle.
+ *
+ * @version V1.0 2025-05-10
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_pwm.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+static TIM_HandleTypeDef htim_led_pwm;
+/* Duty[Q16] kept to rescale CCR when the period is changed               */
+static uint32_t          led_pwm_duty = 0;
+/* Cycles of the blink still to start, counted down by the update IRQ     */
+static volatile uint32_t led_pwm_cycles_left = 0;
+
+/**
+ * @brief  program the compare value of the channel from a Q16 duty.
+ * @param[in] duty : Duty[Q16 of LED_DUTY_FULL].
+ * @retval LED_OK if success.
+ */
+static led_status_t __led_pwm_write_ccr(const uint32_t duty)
+{
+    uint32_t period = __HAL_TIM_GET_AUTORELOAD(&htim_led_pwm) + 1U;
+    uint32_t ccr    = (uint32_t)(((uint64_t)period * duty) / LED_DUTY_FULL);
+
+    __HAL_TIM_SET_COMPARE(&htim_led_pwm, LED_PWM_TIM_CHANNEL, ccr);
+
+    return LED_OK;
+}
+
+/**
+ * @brief This function handles TIM2 global interrupt.
+ */
+void TIM2_IRQHandler(void)
+{
+    if ( 0 == (LED_PWM_TIM->SR & TIM_SR_UIF) )
+    {
+        return;
+    }
+    LED_PWM_TIM->SR = ~TIM_SR_UIF;
+
+    // the last cycle has just started, CCR is preloaded, so the off level
+    // is loaded by the update at its end.
+    if ( 0 == --led_pwm_cycles_left )
+    {
+        __HAL_TIM_DISABLE_IT(&htim_led_pwm, TIM_IT_UPDATE);
+        led_pwm_duty = 0;
+        __led_pwm_write_ccr(0);
+    }
+}
+
+/**
+ * @brief  set the duty of the PWM channel, a count of cycles is dropped.
+ * @param[in] duty : Duty[Q16 of LED_DUTY_FULL], LED_DUTY_FULL is always on.
+ * @retval LED_OK if success.
+ */
+led_status_t led_pwm_set_duty (const uint32_t duty)
+{
+    if ( duty > LED_DUTY_FULL )
+    {
+        DEBUG_OUT("Error: led_pwm_set_duty Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    // the IRQ is stopped first, it must not clear the new duty.
+    __HAL_TIM_DISABLE_IT(&htim_led_pwm, TIM_IT_UPDATE);
+    led_pwm_cycles_left = 0;
+    led_pwm_duty        = duty;
+
+    return __led_pwm_write_ccr(duty);
+}
+
+/**
+ * @brief  set the period of the PWM channel and restart it from the on edge.
+ * @param[in] period_us : Period[us] of one cycle.
+ * @retval LED_OK if success.
+ */
+led_status_t led_pwm_set_period (const uint32_t period_us)
+{
+    if ( 0 == period_us )
+    {
+        DEBUG_OUT("Error: led_pwm_set_period Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    __HAL_TIM_SET_AUTORELOAD(&htim_led_pwm, period_us - 1U);
+    __led_pwm_write_ccr(led_pwm_duty);
+    /* Load the preloaded ARR/CCR and restart the counter */
+    htim_led_pwm.Instance->EGR = TIM_EGR_UG;
+
+    return LED_OK;
+}
+
+/**
+ * @brief  restart the cycle and turn the output off after the given cycles.
+ * @param[in] cycles : Number of cycles, the first one starts now.
+ * @retval LED_OK if success.
+ */
+led_status_t led_pwm_set_count (const uint32_t cycles)
+{
+    if ( 0 == cycles )
+    {
+        DEBUG_OUT("Error: led_pwm_set_count Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    __HAL_TIM_DISABLE_IT(&htim_led_pwm, TIM_IT_UPDATE);
+    led_pwm_cycles_left = cycles - 1U;
+    if ( 0 == led_pwm_cycles_left )
+    {
+        led_pwm_duty = 0;
+        return __led_pwm_write_ccr(0);
+    }
+
+    // restart the first cycle here, so no update is lost before the count.
+    htim_led_pwm.Instance->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_IT(&htim_led_pwm, TIM_IT_UPDATE);
+    __HAL_TIM_ENABLE_IT(&htim_led_pwm, TIM_IT_UPDATE);
+
+    return LED_OK;
+}
+
+/**
+ * @brief  turn the led fully on.
+ * @retval LED_OK if success.
+ */
+led_status_t led_pwm_on (void)
+{
+    return led_pwm_set_duty(LED_DUTY_FULL);
+}
+
+/**
+ * @brief  turn the led off.
+ * @retval LED_OK if success.
+ */
+led_status_t led_pwm_off (void)
+{
+    return led_pwm_set_duty(0);
+}
+
+led_operations_t led_pwm_ops = 
+{
+    .pf_led_on         =         led_pwm_on,
+    .pf_led_off        =        led_pwm_off,
+    .pf_led_set_duty   =   led_pwm_set_duty,
+    .pf_led_set_period = led_pwm_set_period,
+    .pf_led_set_count  =  led_pwm_set_count,
+};
+
+/**
+ * @brief init the timer and the pin of the PWM channel, the led is off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_pwm_init(void)
+{
+    GPIO_InitTypeDef   gpio_init  = { 0 };
+    TIM_OC_InitTypeDef oc_init    = { 0 };
+    uint32_t           tim_clock  = HAL_RCC_GetPCLK1Freq();
+
+    DEBUG_OUT("Info: Enter system_led_pwm_init!\r\n");
+
+    /* APB1 timers run at twice PCLK1 when APB1 is divided */
+    if ( RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE1) )
+    {
+        tim_clock *= 2U;
+    }
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    gpio_init.Pin       =           LED_PWM_Pin;
+    gpio_init.Mode      =       GPIO_MODE_AF_PP;
+    gpio_init.Pull      =           GPIO_NOPULL;
+    gpio_init.Speed     =   GPIO_SPEED_FREQ_LOW;
+    gpio_init.Alternate =       LED_PWM_GPIO_AF;
+    HAL_GPIO_Init(LED_PWM_GPIO_Port, &gpio_init);
+
+    htim_led_pwm.Instance               =                        LED_PWM_TIM;
+    htim_led_pwm.Init.Prescaler         = tim_clock / LED_PWM_COUNTER_HZ - 1U;
+    htim_led_pwm.Init.CounterMode       =                 TIM_COUNTERMODE_UP;
+    htim_led_pwm.Init.Period            =      LED_PWM_DEFAULT_PERIOD_US - 1U;
+    htim_led_pwm.Init.ClockDivision     =             TIM_CLOCKDIVISION_DIV1;
+    htim_led_pwm.Init.AutoReloadPreload =     TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if ( HAL_OK != HAL_TIM_PWM_Init(&htim_led_pwm) )
+    {
+        DEBUG_OUT("Error: Init led pwm timer failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    oc_init.OCMode     =       TIM_OCMODE_PWM1;
+    oc_init.Pulse      =                     0;
+    oc_init.OCPolarity =   TIM_OCPOLARITY_HIGH;
+    oc_init.OCFastMode =    TIM_OCFAST_DISABLE;
+    if ( HAL_OK != HAL_TIM_PWM_ConfigChannel(&htim_led_pwm, 
+                                             &oc_init,
+                                             LED_PWM_TIM_CHANNEL) )
+    {
+        DEBUG_OUT("Error: Config led pwm channel failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    // the update IRQ is only enabled while a blink is counted.
+    HAL_NVIC_SetPriority(LED_PWM_TIM_IRQn, LED_PWM_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LED_PWM_TIM_IRQn);
+
+    if ( HAL_OK != HAL_TIM_PWM_Start(&htim_led_pwm, LED_PWM_TIM_CHANNEL) )
+    {
+        DEBUG_OUT("Error: Start led pwm channel failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    return LED_OK;
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_pwm.h
+ *
+ * @par dependencies
+ * - main.h
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief timer PWM backend of led_operations_t.
+ *
+ * Processing flow:
+ *
+ * system_led_pwm_init() -> mount led_pwm_ops to a bsp_led_driver_t.
+ *
+ * Both edges of a blink come from the compare of the channel, and the 
+ * update IRQ counts the cycles of a blink to end it after the last one.
+ *
+ * @version V1.0 2025-05-10
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_PWM_H__
+#define __SYSTEM_LED_PWM_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+
+#include "bsp_led_driver.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* TIM2 is 32 bits, so any blink period[us] fits without prescaler tricks   */
+#define LED_PWM_TIM                  TIM2
+#define LED_PWM_TIM_CHANNEL          TIM_CHANNEL_1
+#define LED_PWM_GPIO_Port            GPIOA
+#define LED_PWM_Pin                  GPIO_PIN_5
+#define LED_PWM_GPIO_AF              GPIO_AF1_TIM2
+#define LED_PWM_TIM_IRQn             TIM2_IRQn
+/* The ISR has the whole last cycle to stop the output, it could wait 
+   behind the kernel                                                       */
+#define LED_PWM_IRQ_PRIORITY         (6U)
+
+/* Counter clock of the timer, 1 tick == 1 us                              */
+#define LED_PWM_COUNTER_HZ           (1000000U)
+/* Period[us] of the channel after init, 1 kHz for brightness control      */
+#define LED_PWM_DEFAULT_PERIOD_US    (1000U)
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations which drive the led by the PWM channel               */
+extern led_operations_t led_pwm_ops;
+
+/**
+ * @brief init the timer and the pin of the PWM channel, the led is off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_pwm_init(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_PWM_H__
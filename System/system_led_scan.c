@@ -0,0 +1,224 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_scan.c
+ *
+ * @par dependencies
+ * - system_led_scan.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief matrix scan backend of led_operations_t on one timer.
+ *
+ * Processing flow:
+ *
+ * The update interrupt of the timer lights the next row and sets ARR to
+ * the dwell of that row, so a frame costs one interrupt per row.
+ *
+ * @version V1.0 2025-06-02
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_scan.h"
+#include "FreeRTOS.h"
+#include "task.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+static const uint16_t led_scan_row_pins[LED_SCAN_ROW_NUM] = 
+{
+    GPIO_PIN_0, GPIO_PIN_1, GPIO_PIN_2, GPIO_PIN_3,
+    GPIO_PIN_4, GPIO_PIN_5, GPIO_PIN_6, GPIO_PIN_7,
+};
+static const uint16_t led_scan_col_pins[LED_SCAN_COL_NUM] = 
+{
+    GPIO_PIN_0, GPIO_PIN_1, GPIO_PIN_2, GPIO_PIN_3,
+    GPIO_PIN_4, GPIO_PIN_5, GPIO_PIN_6, GPIO_PIN_7,
+};
+static const led_scan_config_t led_scan_config = 
+{
+    .type           =                            LED_SCAN_MATRIX,
+    .row_num        =                           LED_SCAN_ROW_NUM,
+    .col_num        =                           LED_SCAN_COL_NUM,
+    .p_row_pins     =                          led_scan_row_pins,
+    .p_col_pins     =                          led_scan_col_pins,
+    .row_active_low =                                          0,
+    .col_active_low =                                          1,
+    .p_row_bsrr     =             &(LED_SCAN_ROW_GPIO_Port->BSRR),
+    .p_col_bsrr     =             &(LED_SCAN_COL_GPIO_Port->BSRR),
+    .p_moder        =                                       NULL,
+    .dwell_us       = LED_SCAN_COUNTER_HZ / 
+                                (LED_SCAN_FRAME_HZ * LED_SCAN_ROW_NUM),
+};
+
+static TIM_HandleTypeDef htim_led_scan;
+static led_scan_t        led_scan;
+
+/**
+ * @brief This function handles TIM4 global interrupt.
+ */
+void TIM4_IRQHandler(void)
+{
+    uint32_t dwell_us = 0;
+
+    if ( 0 == (LED_SCAN_TIM->SR & TIM_SR_UIF) )
+    {
+        return;
+    }
+    LED_SCAN_TIM->SR = ~TIM_SR_UIF;
+
+    // ARR is not preloaded and the counter has just restarted, so the new
+    // value already ends the row being lit.
+    dwell_us          = led_scan_isr(&led_scan);
+    LED_SCAN_TIM->ARR =           dwell_us - 1U;
+}
+
+/**
+ * @brief  request the level of a cell, it is shown after the flush.
+ * @param[in] cell  : Index of the cell, LED_SCAN_CELL(row, col, n).
+ * @param[in] is_on : Non-zero to light the led.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_scan_write(
+                            const uint32_t                          cell,
+                            const uint32_t                         is_on
+                                  )
+{
+    led_status_t ret = LED_OK;
+
+    taskENTER_CRITICAL();
+    ret = led_scan_cell_write(&led_scan, cell, is_on);
+    taskEXIT_CRITICAL();
+
+    return ret;
+}
+
+/**
+ * @brief  build the steps of the cells changed since the last call.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_scan_flush(void)
+{
+    taskENTER_CRITICAL();
+    led_scan_commit(&led_scan);
+    taskEXIT_CRITICAL();
+
+    return LED_OK;
+}
+
+/**
+ * @brief  set the dwell of the rows, the refresh rate is 1 / the sum.
+ * @param[in] row      : Index of the row, LED_SCAN_ROW_NUM for all.
+ * @param[in] dwell_us : Dwell[us] of the row, up to the 16-bit counter.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_scan_dwell_set(
+                            const uint32_t                           row,
+                            const uint32_t                      dwell_us
+                                      )
+{
+    led_status_t ret = LED_OK;
+
+    if ( dwell_us > 0x10000U )
+    {
+        DEBUG_OUT("Error: system_led_scan_dwell_set Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    taskENTER_CRITICAL();
+    ret = led_scan_dwell_set(&led_scan, row, dwell_us);
+    taskEXIT_CRITICAL();
+
+    return ret;
+}
+
+SYSTEM_LED_SCAN_OPS_DEFINE(led_scan_r0c0_ops, 0, 0);
+SYSTEM_LED_SCAN_OPS_DEFINE(led_scan_r7c7_ops, 7, 7);
+
+/**
+ * @brief init the pins of the matrix and start the timer, every led is
+ *        off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_scan_init(void)
+{
+    GPIO_InitTypeDef gpio_init = { 0 };
+    uint32_t         row_pins  = 0;
+    uint32_t         col_pins  = 0;
+    uint32_t         tim_clock = HAL_RCC_GetPCLK1Freq();
+    led_status_t     ret       = LED_OK;
+
+    DEBUG_OUT("Info: Enter system_led_scan_init!\r\n");
+
+    /* APB1 timers run at twice PCLK1 when APB1 is divided */
+    if ( RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE1) )
+    {
+        tim_clock *= 2U;
+    }
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_TIM4_CLK_ENABLE();
+
+    /*********************1.the pins of the matrix*************************/
+    for (uint32_t index = 0; index < LED_SCAN_ROW_NUM; index++)
+    {
+        row_pins |= led_scan_row_pins[index];
+    }
+    for (uint32_t index = 0; index < LED_SCAN_COL_NUM; index++)
+    {
+        col_pins |= led_scan_col_pins[index];
+    }
+    // no row is selected and no column is lit before the first scan.
+    HAL_GPIO_WritePin(LED_SCAN_ROW_GPIO_Port, row_pins, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(LED_SCAN_COL_GPIO_Port, col_pins,   GPIO_PIN_SET);
+
+    gpio_init.Mode  =       GPIO_MODE_OUTPUT_PP;
+    gpio_init.Pull  =               GPIO_NOPULL;
+    gpio_init.Speed =    GPIO_SPEED_FREQ_MEDIUM;
+    gpio_init.Pin   =                  row_pins;
+    HAL_GPIO_Init(LED_SCAN_ROW_GPIO_Port, &gpio_init);
+    gpio_init.Pin   =                  col_pins;
+    HAL_GPIO_Init(LED_SCAN_COL_GPIO_Port, &gpio_init);
+
+    ret = led_scan_init(&led_scan, &led_scan_config);
+    if ( LED_OK != ret )
+    {
+        return ret;
+    }
+
+    /*********************2.the timer of the rows**************************/
+    htim_led_scan.Instance               =                      LED_SCAN_TIM;
+    htim_led_scan.Init.Prescaler         = 
+                                     tim_clock / LED_SCAN_COUNTER_HZ - 1U;
+    htim_led_scan.Init.CounterMode       =               TIM_COUNTERMODE_UP;
+    htim_led_scan.Init.Period            =     led_scan_config.dwell_us - 1U;
+    htim_led_scan.Init.ClockDivision     =           TIM_CLOCKDIVISION_DIV1;
+    htim_led_scan.Init.AutoReloadPreload =  TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if ( HAL_OK != HAL_TIM_Base_Init(&htim_led_scan) )
+    {
+        DEBUG_OUT("Error: Init led scan timer failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    HAL_NVIC_SetPriority(LED_SCAN_TIM_IRQn, LED_SCAN_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LED_SCAN_TIM_IRQn);
+
+    if ( HAL_OK != HAL_TIM_Base_Start_IT(&htim_led_scan) )
+    {
+        DEBUG_OUT("Error: Start led scan timer failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    return LED_OK;
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_scan.h
+ *
+ * @par dependencies
+ * - main.h
+ * - bsp_led_driver.h
+ * - bsp_led_scan.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief matrix scan backend of led_operations_t on one timer.
+ *
+ * Processing flow:
+ *
+ * system_led_scan_init() -> mount the ops of SYSTEM_LED_SCAN_OPS_DEFINE
+ * to a bsp_led_driver_t per cell, the handler commits the framebuffer 
+ * once per tick, and TIM4 lights one row per interrupt.
+ *
+ * The 8 x 8 matrix has its anode rows on PC0-PC7, active high, and its 
+ * cathode columns on PB0-PB7, lit at low level. The pins are shared with
+ * the bam backend, only one of them is started.
+ *
+ * @version V1.0 2025-06-02
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_SCAN_H__
+#define __SYSTEM_LED_SCAN_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+
+#include "bsp_led_driver.h"
+#include "bsp_led_scan.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define LED_SCAN_TIM                 TIM4
+#define LED_SCAN_TIM_IRQn            TIM4_IRQn
+/* No OS API is called in the ISR, it is above the kernel mask            */
+#define LED_SCAN_IRQ_PRIORITY        (4U)
+/* Counter clock of the timer, 1 tick == 1 us                              */
+#define LED_SCAN_COUNTER_HZ          (1000000U)
+
+#define LED_SCAN_ROW_NUM             (8U)
+#define LED_SCAN_COL_NUM             (8U)
+#define LED_SCAN_ROW_GPIO_Port       GPIOC
+#define LED_SCAN_COL_GPIO_Port       GPIOB
+/* Refresh rate[Hz] of the whole matrix after init                         */
+#define LED_SCAN_FRAME_HZ            (200U)
+
+/* Define the led operations of one cell of the matrix                     */
+#define SYSTEM_LED_SCAN_OPS_DEFINE(name, row, col)                            \
+    static led_status_t name##_on (void)                                      \
+    {                                                                         \
+        return system_led_scan_write(                                         \
+                        LED_SCAN_CELL((row), (col), LED_SCAN_COL_NUM), 1);    \
+    }                                                                         \
+    static led_status_t name##_off (void)                                     \
+    {                                                                         \
+        return system_led_scan_write(                                         \
+                        LED_SCAN_CELL((row), (col), LED_SCAN_COL_NUM), 0);    \
+    }                                                                         \
+    led_operations_t name =                                                   \
+    {                                                                         \
+        .pf_led_on         =             name##_on,                           \
+        .pf_led_off        =            name##_off,                           \
+        .pf_led_flush      = system_led_scan_flush,                           \
+    }
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations of the cells in the corners of the matrix            */
+extern led_operations_t led_scan_r0c0_ops;
+extern led_operations_t led_scan_r7c7_ops;
+
+/**
+ * @brief request the level of a cell, it is shown after the flush.
+ *
+ * @param[in] cell        : Index of the cell, LED_SCAN_CELL(row, col, n).
+ * @param[in] is_on       : Non-zero to light the led.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_scan_write(
+                            const uint32_t                          cell,
+                            const uint32_t                         is_on
+                                  );
+
+/**
+ * @brief build the steps of the cells changed since the last call.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_scan_flush(void);
+
+/**
+ * @brief set the dwell of the rows, the refresh rate is 1 / the sum.
+ *
+ * @param[in] row         : Index of the row, LED_SCAN_ROW_NUM for all.
+ * @param[in] dwell_us    : Dwell[us] of the row, not 0.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_scan_dwell_set(
+                            const uint32_t                           row,
+                            const uint32_t                      dwell_us
+                                      );
+
+/**
+ * @brief init the pins of the matrix and start the timer, every led is
+ *        off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_scan_init(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_SCAN_H__
@@ -0,0 +1,224 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_shift.c
+ *
+ * @par dependencies
+ * - system_led_shift.h
+ * - system_led_spi.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief 74HC595 chain backend of led_operations_t on SPI2 and DMA.
+ *
+ * Processing flow:
+ *
+ * The image is copied into the stream only while the DMA is idle, so the
+ * outputs latched at the end of a transfer are never half old, half new.
+ * An image changed during a transfer is sent by the transfer complete
+ * callback right after the latch.
+ *
+ * @version V1.0 2025-06-06
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_shift.h"
+#include "system_led_spi.h"
+#include "FreeRTOS.h"
+#include "task.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+static SPI_HandleTypeDef hspi_led_shift;
+static DMA_HandleTypeDef hdma_led_shift;
+static led_shift_t       led_shift;
+static uint8_t           led_shift_image[LED_SHIFT_REG_NUM];
+/* Copy of the image on the wire                                           */
+static uint8_t           led_shift_stream[LED_SHIFT_REG_NUM];
+/* Non-zero while the DMA sends the stream                                 */
+static volatile uint32_t led_shift_busy    = 0;
+/* Non-zero if the image changed during the transfer                       */
+static volatile uint32_t led_shift_pending = 0;
+
+/**
+ * @brief  send the image if it changed, the DMA is idle.
+ */
+static void __led_shift_send(void)
+{
+    led_shift_pending = 0;
+    if ( 0 == led_shift_commit(&led_shift, led_shift_stream) )
+    {
+        return;
+    }
+
+    if ( HAL_OK != HAL_SPI_Transmit_DMA(&hspi_led_shift, led_shift_stream,
+                                        LED_SHIFT_REG_NUM) )
+    {
+        DEBUG_OUT("Error: Send led shift image failed!\r\n");
+        return;
+    }
+    led_shift_busy = 1;
+}
+
+/**
+ * @brief This function handles DMA1 stream4 global interrupt.
+ */
+void DMA1_Stream4_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_led_shift);
+}
+
+/**
+ * @brief  the image is on the wire, latch it and send the next one.
+ * @param[in] hspi : The SPI which is done.
+ */
+void system_led_shift_tx_cplt(SPI_HandleTypeDef *hspi)
+{
+    if ( &hspi_led_shift != hspi )
+    {
+        return;
+    }
+
+    // the last bit is out, the read back holds RCLK high over 20 ns.
+    LED_SHIFT_GPIO_Port->BSRR = LED_SHIFT_LATCH_Pin;
+    (void)LED_SHIFT_GPIO_Port->ODR;
+    LED_SHIFT_GPIO_Port->BSRR = (uint32_t)LED_SHIFT_LATCH_Pin << 16;
+
+    led_shift_busy = 0;
+    if ( 0 != led_shift_pending )
+    {
+        __led_shift_send();
+    }
+}
+
+/**
+ * @brief  request the level of an output, it is sent after the flush.
+ * @param[in] output : Index of the output along the chain.
+ * @param[in] is_on  : Non-zero to light the led.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_shift_write(
+                            const uint32_t                        output,
+                            const uint32_t                         is_on
+                                   )
+{
+    led_status_t ret = LED_OK;
+
+    taskENTER_CRITICAL();
+    ret = led_shift_write(&led_shift, output, is_on);
+    taskEXIT_CRITICAL();
+
+    return ret;
+}
+
+/**
+ * @brief  send the image if an output changed since the last call.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_shift_flush(void)
+{
+    // the callback is masked, so it neither sends nor latches meanwhile.
+    taskENTER_CRITICAL();
+    if ( 0 == led_shift_busy )
+    {
+        __led_shift_send();
+    }
+    else
+    {
+        led_shift_pending = led_shift.dirty;
+    }
+    taskEXIT_CRITICAL();
+
+    return LED_OK;
+}
+
+SYSTEM_LED_SHIFT_OPS_DEFINE(led_shift_out0_ops  ,   0);
+SYSTEM_LED_SHIFT_OPS_DEFINE(led_shift_out127_ops, 127);
+
+/**
+ * @brief init SPI2, its DMA stream and the pins, every led is off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_shift_init(void)
+{
+    GPIO_InitTypeDef gpio_init = { 0 };
+
+    DEBUG_OUT("Info: Enter system_led_shift_init!\r\n");
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_SPI2_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    HAL_GPIO_WritePin(LED_SHIFT_GPIO_Port, LED_SHIFT_LATCH_Pin,
+                      GPIO_PIN_RESET);
+    gpio_init.Pin       =                   LED_SHIFT_LATCH_Pin;
+    gpio_init.Mode      =                   GPIO_MODE_OUTPUT_PP;
+    gpio_init.Pull      =                           GPIO_NOPULL;
+    gpio_init.Speed     =                  GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(LED_SHIFT_GPIO_Port, &gpio_init);
+
+    gpio_init.Pin       = LED_SHIFT_SCK_Pin | LED_SHIFT_MOSI_Pin;
+    gpio_init.Mode      =                       GPIO_MODE_AF_PP;
+    gpio_init.Alternate =                     LED_SHIFT_GPIO_AF;
+    HAL_GPIO_Init(LED_SHIFT_GPIO_Port, &gpio_init);
+
+    // the 595 shifts on the rising edge of SRCLK.
+    hspi_led_shift.Instance               =              LED_SHIFT_SPI;
+    hspi_led_shift.Init.Mode              =            SPI_MODE_MASTER;
+    hspi_led_shift.Init.Direction         =      SPI_DIRECTION_2LINES;
+    hspi_led_shift.Init.DataSize          =         SPI_DATASIZE_8BIT;
+    hspi_led_shift.Init.CLKPolarity       =          SPI_POLARITY_LOW;
+    hspi_led_shift.Init.CLKPhase          =           SPI_PHASE_1EDGE;
+    hspi_led_shift.Init.NSS               =              SPI_NSS_SOFT;
+    // the fastest clock not over LED_SHIFT_SPI_HZ_MAX.
+    hspi_led_shift.Init.BaudRatePrescaler = 
+                        system_led_spi_prescaler_get(HAL_RCC_GetPCLK1Freq(),
+                                                     LED_SHIFT_SPI_HZ_MAX);
+    hspi_led_shift.Init.FirstBit          =          SPI_FIRSTBIT_MSB;
+    hspi_led_shift.Init.TIMode            =        SPI_TIMODE_DISABLE;
+    hspi_led_shift.Init.CRCCalculation    = SPI_CRCCALCULATION_DISABLE;
+    if ( HAL_OK != HAL_SPI_Init(&hspi_led_shift) )
+    {
+        DEBUG_OUT("Error: Init led shift spi failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    hdma_led_shift.Instance                 =      LED_SHIFT_DMA_STREAM;
+    hdma_led_shift.Init.Channel             =     LED_SHIFT_DMA_CHANNEL;
+    hdma_led_shift.Init.Direction           =      DMA_MEMORY_TO_PERIPH;
+    hdma_led_shift.Init.PeriphInc           =          DMA_PINC_DISABLE;
+    hdma_led_shift.Init.MemInc              =           DMA_MINC_ENABLE;
+    hdma_led_shift.Init.PeriphDataAlignment =       DMA_PDATAALIGN_BYTE;
+    hdma_led_shift.Init.MemDataAlignment    =       DMA_MDATAALIGN_BYTE;
+    hdma_led_shift.Init.Mode                =                DMA_NORMAL;
+    hdma_led_shift.Init.Priority            =         DMA_PRIORITY_HIGH;
+    hdma_led_shift.Init.FIFOMode            =      DMA_FIFOMODE_DISABLE;
+    if ( HAL_OK != HAL_DMA_Init(&hdma_led_shift) )
+    {
+        DEBUG_OUT("Error: Init led shift dma failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+    __HAL_LINKDMA(&hspi_led_shift, hdmatx, hdma_led_shift);
+
+    HAL_NVIC_SetPriority(LED_SHIFT_DMA_IRQn, LED_SHIFT_DMA_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LED_SHIFT_DMA_IRQn);
+
+    if ( LED_OK != led_shift_init(&led_shift, led_shift_image,
+                                  LED_SHIFT_REG_NUM, 0) )
+    {
+        return LED_ERRORRESOURCE;
+    }
+
+    // the registers may hold outputs from before the reset.
+    return system_led_shift_flush();
+}
+//******************************** Defines **********************************//
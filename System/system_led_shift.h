@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_shift.h
+ *
+ * @par dependencies
+ * - main.h
+ * - bsp_led_driver.h
+ * - bsp_led_shift.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief 74HC595 chain backend of led_operations_t on SPI2 and DMA.
+ *
+ * Processing flow:
+ *
+ * system_led_shift_init() -> mount the ops of SYSTEM_LED_SHIFT_OPS_DEFINE
+ * to a bsp_led_driver_t per output, a led flips one bit of the image, the
+ * handler sends the image once per tick by one DMA transfer and the latch
+ * is pulsed when the last bit is out.
+ *
+ * SRCLK is SCK on PB13, SER is MOSI on PB15 and RCLK is PB12. The pins are
+ * shared with the bam example, only one of them is started.
+ *
+ * @version V1.0 2025-06-06
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_SHIFT_H__
+#define __SYSTEM_LED_SHIFT_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+
+#include "bsp_led_driver.h"
+#include "bsp_led_shift.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define LED_SHIFT_SPI                SPI2
+#define LED_SHIFT_GPIO_Port          GPIOB
+#define LED_SHIFT_SCK_Pin            GPIO_PIN_13
+#define LED_SHIFT_MOSI_Pin           GPIO_PIN_15
+#define LED_SHIFT_LATCH_Pin          GPIO_PIN_12
+#define LED_SHIFT_GPIO_AF            GPIO_AF5_SPI2
+/* SPI2_TX is mapped to DMA1 stream 4 channel 0                            */
+#define LED_SHIFT_DMA_STREAM         DMA1_Stream4
+#define LED_SHIFT_DMA_CHANNEL        DMA_CHANNEL_0
+#define LED_SHIFT_DMA_IRQn           DMA1_Stream4_IRQn
+/* The callback is ordered with the flush by the kernel mask              */
+#define LED_SHIFT_DMA_IRQ_PRIORITY   (5U)
+/* Fastest SPI clock[Hz], with margin for the 595 at 3.3 V on long wires  */
+#define LED_SHIFT_SPI_HZ_MAX         (6250000U)
+/* Registers of the chain, 8 leds per register                             */
+#define LED_SHIFT_REG_NUM            (16U)
+
+/* Define the led operations of one output of the chain                    */
+#define SYSTEM_LED_SHIFT_OPS_DEFINE(name, output)                             \
+    static led_status_t name##_on (void)                                      \
+    {                                                                         \
+        return system_led_shift_write((output), 1);                           \
+    }                                                                         \
+    static led_status_t name##_off (void)                                     \
+    {                                                                         \
+        return system_led_shift_write((output), 0);                           \
+    }                                                                         \
+    led_operations_t name =                                                   \
+    {                                                                         \
+        .pf_led_on         =              name##_on,                          \
+        .pf_led_off        =             name##_off,                          \
+        .pf_led_flush      = system_led_shift_flush,                          \
+    }
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations of the first and the last output of the chain        */
+extern led_operations_t led_shift_out0_ops;
+extern led_operations_t led_shift_out127_ops;
+
+/**
+ * @brief request the level of an output, it is sent after the flush.
+ *
+ * @param[in] output      : Index of the output along the chain.
+ * @param[in] is_on       : Non-zero to light the led.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_shift_write(
+                            const uint32_t                        output,
+                            const uint32_t                         is_on
+                                   );
+
+/**
+ * @brief send the image if an output changed since the last call, at once
+ *        or as soon as the transfer on the wire is done.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_shift_flush(void);
+
+/**
+ * @brief end of a transfer, called by HAL_SPI_TxCpltCallback() of any SPI.
+ *
+ * @param[in] hspi        : The SPI which is done.
+ *
+ * */
+void system_led_shift_tx_cplt(SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief init SPI2, its DMA stream and the pins, every led is off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_shift_init(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_SHIFT_H__
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_spi.c
+ *
+ * @par dependencies
+ * - system_led_spi.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief SPI clock setup shared by the SPI backends of the leds.
+ *
+ * Processing flow:
+ *
+ * call directly.
+ *
+ * @version V1.0 2025-06-06
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_spi.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/* SPI clock is the APB clock divided by 2 << index of the prescaler       */
+static const uint32_t led_spi_prescalers[] = 
+{
+    SPI_BAUDRATEPRESCALER_2  , SPI_BAUDRATEPRESCALER_4  ,
+    SPI_BAUDRATEPRESCALER_8  , SPI_BAUDRATEPRESCALER_16 ,
+    SPI_BAUDRATEPRESCALER_32 , SPI_BAUDRATEPRESCALER_64 ,
+    SPI_BAUDRATEPRESCALER_128, SPI_BAUDRATEPRESCALER_256,
+};
+
+/**
+ * @brief get the baud rate prescaler of the fastest SPI clock not over
+ *        the limit, or the slowest clock if even that is over it.
+ *
+ * @param[in] pclk_hz     : Clock[Hz] of the APB bus of the SPI.
+ * @param[in] max_hz      : Fastest SPI clock[Hz] the device takes.
+ *
+ * @return uint32_t : SPI_BAUDRATEPRESCALER_x for SPI_InitTypeDef.
+ *
+ * */
+uint32_t system_led_spi_prescaler_get(const uint32_t pclk_hz,
+                                      const uint32_t  max_hz)
+{
+    const uint32_t last      = sizeof(led_spi_prescalers) /
+                               sizeof(led_spi_prescalers[0]) - 1U;
+    uint32_t       spi_clock = pclk_hz / 2U;
+    uint32_t       index     = 0;
+
+    while ( spi_clock > max_hz && index < last )
+    {
+        spi_clock /= 2U;
+        index++;
+    }
+
+    return led_spi_prescalers[index];
+}
+//******************************** Defines **********************************//
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_spi.h
+ *
+ * @par dependencies
+ * - main.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief SPI clock setup shared by the SPI backends of the leds.
+ *
+ * Processing flow:
+ *
+ * system_led_spi_prescaler_get() once in the init of an SPI backend, e.g.
+ * the ws2812 strip on SPI1 and the 74HC595 chain on SPI2.
+ *
+ * @version V1.0 2025-06-06
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_SPI_H__
+#define __SYSTEM_LED_SPI_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+//******************************** Includes *********************************//
+
+//******************************** Declaring ********************************//
+
+/**
+ * @brief get the baud rate prescaler of the fastest SPI clock not over
+ *        the limit, or the slowest clock if even that is over it.
+ *
+ * @param[in] pclk_hz     : Clock[Hz] of the APB bus of the SPI.
+ * @param[in] max_hz      : Fastest SPI clock[Hz] the device takes.
+ *
+ * @return uint32_t : SPI_BAUDRATEPRESCALER_x for SPI_InitTypeDef.
+ *
+ * */
+uint32_t system_led_spi_prescaler_get(const uint32_t pclk_hz,
+                                      const uint32_t  max_hz);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_SPI_H__
@@ -0,0 +1,237 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_ws2812.c
+ *
+ * @par dependencies
+ * - system_led_ws2812.h
+ * - system_led_spi.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief WS2812 chain backend of led_operations_t on SPI1 and DMA.
+ *
+ * Processing flow:
+ *
+ * Two frames of stream are kept. The flush encodes into the one which is
+ * not on the wire and starts it at once if the DMA is idle, else the 
+ * transfer complete callback starts it, so the CPU never waits for the
+ * wire and a frame is never changed while it is sent.
+ *
+ * @version V1.0 2025-06-04
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_led_ws2812.h"
+#include "system_led_spi.h"
+#include "FreeRTOS.h"
+#include "task.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+static SPI_HandleTypeDef  hspi_led_ws2812;
+static DMA_HandleTypeDef  hdma_led_ws2812;
+static led_ws2812_pixel_t led_ws2812_pixels[LED_WS2812_PIXEL_NUM];
+/* Two frames, the low bytes at the end latch the chain                    */
+static uint8_t            led_ws2812_frames[2][LED_WS2812_FRAME_BYTES];
+/* Non-zero if a pixel changed since the flush                             */
+static uint32_t           led_ws2812_dirty   = 0;
+/* Frame which is encoded, the other one may be on the wire                */
+static uint32_t           led_ws2812_back    = 0;
+/* Non-zero while the DMA sends a frame                                    */
+static volatile uint32_t  led_ws2812_busy    = 0;
+/* Non-zero if the back frame waits for the wire                           */
+static volatile uint32_t  led_ws2812_pending = 0;
+
+/**
+ * @brief  send the back frame, the DMA is idle.
+ */
+static void __led_ws2812_send(void)
+{
+    if ( HAL_OK != HAL_SPI_Transmit_DMA(&hspi_led_ws2812,
+                                        led_ws2812_frames[led_ws2812_back],
+                                        LED_WS2812_FRAME_BYTES) )
+    {
+        DEBUG_OUT("Error: Send led ws2812 frame failed!\r\n");
+        return;
+    }
+
+    led_ws2812_busy     =                     1;
+    led_ws2812_pending  =                     0;
+    led_ws2812_back    ^=                    1U;
+}
+
+/**
+ * @brief This function handles DMA2 stream3 global interrupt.
+ */
+void DMA2_Stream3_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_led_ws2812);
+}
+
+/**
+ * @brief  the frame is on the wire, send the next one if it is encoded.
+ * @param[in] hspi : The SPI which is done.
+ */
+void system_led_ws2812_tx_cplt(SPI_HandleTypeDef *hspi)
+{
+    if ( &hspi_led_ws2812 != hspi )
+    {
+        return;
+    }
+
+    led_ws2812_busy = 0;
+    if ( 0 != led_ws2812_pending )
+    {
+        __led_ws2812_send();
+    }
+}
+
+/**
+ * @brief  request the color of a pixel, it is sent after the flush.
+ * @param[in] pixel   : Index of the pixel in the chain.
+ * @param[in] p_color : The color at full duty.
+ * @param[in] duty    : Duty[Q16 of LED_DUTY_FULL].
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_ws2812_write(
+                            const uint32_t                         pixel,
+                            const led_ws2812_pixel_t *const      p_color,
+                            const uint32_t                          duty
+                                    )
+{
+    led_ws2812_pixel_t color = { 0 };
+
+    if ( pixel >= LED_WS2812_PIXEL_NUM || NULL == p_color || 
+         duty  >  LED_DUTY_FULL
+       )
+    {
+        DEBUG_OUT("Error: system_led_ws2812_write Parameter error!\r\n");
+        return LED_ERRORPARAMETER;
+    }
+
+    color = led_ws2812_pixel_scale(p_color, duty);
+
+    taskENTER_CRITICAL();
+    if ( color.r != led_ws2812_pixels[pixel].r ||
+         color.g != led_ws2812_pixels[pixel].g ||
+         color.b != led_ws2812_pixels[pixel].b
+       )
+    {
+        led_ws2812_pixels[pixel] = color;
+        led_ws2812_dirty         =     1;
+    }
+    taskEXIT_CRITICAL();
+
+    return LED_OK;
+}
+
+/**
+ * @brief  encode the pixels changed since the last call and send them as
+ *         soon as the frame on the wire is done.
+ * @retval LED_OK if success.
+ */
+led_status_t system_led_ws2812_flush(void)
+{
+    // the callback is masked, so it neither sends nor swaps meanwhile.
+    taskENTER_CRITICAL();
+    if ( 0 != led_ws2812_dirty )
+    {
+        led_ws2812_dirty   = 0;
+        led_ws2812_pending = 0;
+        led_ws2812_encode(led_ws2812_pixels, LED_WS2812_PIXEL_NUM,
+                          led_ws2812_frames[led_ws2812_back]);
+        if ( 0 == led_ws2812_busy )
+        {
+            __led_ws2812_send();
+        }
+        else
+        {
+            led_ws2812_pending = 1;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return LED_OK;
+}
+
+SYSTEM_LED_WS2812_OPS_DEFINE(led_pixel0_ops, 0, 255,   0,   0);
+SYSTEM_LED_WS2812_OPS_DEFINE(led_pixel1_ops, 1,   0, 255,   0);
+SYSTEM_LED_WS2812_OPS_DEFINE(led_pixel2_ops, 2,   0,   0, 255);
+
+/**
+ * @brief init SPI1, its DMA stream and the data pin, every pixel is off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_ws2812_init(void)
+{
+    GPIO_InitTypeDef gpio_init = { 0 };
+
+    DEBUG_OUT("Info: Enter system_led_ws2812_init!\r\n");
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_SPI1_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    gpio_init.Pin       =        LED_WS2812_Pin;
+    gpio_init.Mode      =       GPIO_MODE_AF_PP;
+    gpio_init.Pull      =         GPIO_PULLDOWN;
+    gpio_init.Speed     =  GPIO_SPEED_FREQ_HIGH;
+    gpio_init.Alternate =    LED_WS2812_GPIO_AF;
+    HAL_GPIO_Init(LED_WS2812_GPIO_Port, &gpio_init);
+
+    hspi_led_ws2812.Instance               =            LED_WS2812_SPI;
+    hspi_led_ws2812.Init.Mode              =           SPI_MODE_MASTER;
+    hspi_led_ws2812.Init.Direction         =     SPI_DIRECTION_2LINES;
+    hspi_led_ws2812.Init.DataSize          =        SPI_DATASIZE_8BIT;
+    hspi_led_ws2812.Init.CLKPolarity       =         SPI_POLARITY_LOW;
+    hspi_led_ws2812.Init.CLKPhase          =            SPI_PHASE_1EDGE;
+    hspi_led_ws2812.Init.NSS               =              SPI_NSS_SOFT;
+    // the fastest clock not over LED_WS2812_SPI_HZ_MAX.
+    hspi_led_ws2812.Init.BaudRatePrescaler = 
+                        system_led_spi_prescaler_get(HAL_RCC_GetPCLK2Freq(),
+                                                     LED_WS2812_SPI_HZ_MAX);
+    hspi_led_ws2812.Init.FirstBit          =          SPI_FIRSTBIT_MSB;
+    hspi_led_ws2812.Init.TIMode            =          SPI_TIMODE_DISABLE;
+    hspi_led_ws2812.Init.CRCCalculation    = SPI_CRCCALCULATION_DISABLE;
+    if ( HAL_OK != HAL_SPI_Init(&hspi_led_ws2812) )
+    {
+        DEBUG_OUT("Error: Init led ws2812 spi failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+
+    hdma_led_ws2812.Instance                 =     LED_WS2812_DMA_STREAM;
+    hdma_led_ws2812.Init.Channel             =    LED_WS2812_DMA_CHANNEL;
+    hdma_led_ws2812.Init.Direction           =     DMA_MEMORY_TO_PERIPH;
+    hdma_led_ws2812.Init.PeriphInc           =        DMA_PINC_DISABLE;
+    hdma_led_ws2812.Init.MemInc              =         DMA_MINC_ENABLE;
+    hdma_led_ws2812.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_led_ws2812.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    hdma_led_ws2812.Init.Mode                =              DMA_NORMAL;
+    hdma_led_ws2812.Init.Priority            =     DMA_PRIORITY_HIGH;
+    hdma_led_ws2812.Init.FIFOMode            =    DMA_FIFOMODE_DISABLE;
+    if ( HAL_OK != HAL_DMA_Init(&hdma_led_ws2812) )
+    {
+        DEBUG_OUT("Error: Init led ws2812 dma failed!\r\n");
+        return LED_ERRORRESOURCE;
+    }
+    __HAL_LINKDMA(&hspi_led_ws2812, hdmatx, hdma_led_ws2812);
+
+    HAL_NVIC_SetPriority(LED_WS2812_DMA_IRQn, LED_WS2812_DMA_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LED_WS2812_DMA_IRQn);
+
+    // the chain may hold colors from before the reset.
+    led_ws2812_dirty = 1;
+
+    return system_led_ws2812_flush();
+}
+//******************************** Defines **********************************//
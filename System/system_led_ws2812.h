@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_led_ws2812.h
+ *
+ * @par dependencies
+ * - main.h
+ * - bsp_led_driver.h
+ * - bsp_led_ws2812.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief WS2812 chain backend of led_operations_t on SPI1 and DMA.
+ *
+ * Processing flow:
+ *
+ * system_led_ws2812_init() -> mount the ops of SYSTEM_LED_WS2812_OPS_DEFINE
+ * to a bsp_led_driver_t per pixel, the handler encodes the framebuffer 
+ * once per tick and the DMA sends it while the next one is encoded.
+ *
+ * The data line is MOSI on PA7, it is shared with the bam example, only 
+ * one of them is started.
+ *
+ * @version V1.0 2025-06-04
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_LED_WS2812_H__
+#define __SYSTEM_LED_WS2812_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+
+#include "bsp_led_driver.h"
+#include "bsp_led_ws2812.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define LED_WS2812_SPI               SPI1
+#define LED_WS2812_GPIO_Port         GPIOA
+#define LED_WS2812_Pin               GPIO_PIN_7
+#define LED_WS2812_GPIO_AF           GPIO_AF5_SPI1
+/* SPI1_TX is mapped to DMA2 stream 3 channel 3                            */
+#define LED_WS2812_DMA_STREAM        DMA2_Stream3
+#define LED_WS2812_DMA_CHANNEL       DMA_CHANNEL_3
+#define LED_WS2812_DMA_IRQn          DMA2_Stream3_IRQn
+/* The callback is ordered with the flush by the kernel mask              */
+#define LED_WS2812_DMA_IRQ_PRIORITY  (5U)
+/* Fastest SPI clock[Hz], a 0 stays high 1/3 of the bit, about 0.3 us     */
+#define LED_WS2812_SPI_HZ_MAX        (3200000U)
+/* Pixels of the chain                                                     */
+#define LED_WS2812_PIXEL_NUM         (16U)
+/* Low bytes after a frame, over 280 us at LED_WS2812_SPI_HZ_MAX            */
+#define LED_WS2812_RESET_BYTES       (112U)
+/* Bytes of one frame in the DMA buffer                                    */
+#define LED_WS2812_FRAME_BYTES                                                \
+    (LED_WS2812_PIXEL_NUM * LED_WS2812_BYTES_PER_PIXEL + LED_WS2812_RESET_BYTES)
+
+/* Define the led operations of one pixel with its color at full duty      */
+#define SYSTEM_LED_WS2812_OPS_DEFINE(name, pixel, red, green, blue)           \
+    static const led_ws2812_pixel_t name##_color = { (red), (green), (blue) };\
+    static led_status_t name##_on (void)                                      \
+    {                                                                         \
+        return system_led_ws2812_write((pixel), &name##_color,                \
+                                       LED_DUTY_FULL);                        \
+    }                                                                         \
+    static led_status_t name##_off (void)                                     \
+    {                                                                         \
+        return system_led_ws2812_write((pixel), &name##_color, 0);            \
+    }                                                                         \
+    static led_status_t name##_set_duty (const uint32_t duty)                 \
+    {                                                                         \
+        return system_led_ws2812_write((pixel), &name##_color, duty);         \
+    }                                                                         \
+    led_operations_t name =                                                   \
+    {                                                                         \
+        .pf_led_on         =             name##_on,                           \
+        .pf_led_off        =            name##_off,                           \
+        .pf_led_set_duty   =       name##_set_duty,                           \
+        .pf_led_flush      = system_led_ws2812_flush,                         \
+    }
+//******************************** Defines **********************************//
+
+//******************************** Declaring ********************************//
+
+/* The led operations of the first three pixels, red, green and blue       */
+extern led_operations_t led_pixel0_ops;
+extern led_operations_t led_pixel1_ops;
+extern led_operations_t led_pixel2_ops;
+
+/**
+ * @brief request the color of a pixel, it is sent after the flush.
+ *
+ * @param[in] pixel       : Index of the pixel in the chain.
+ * @param[in] p_color     : The color at full duty.
+ * @param[in] duty        : Duty[Q16 of LED_DUTY_FULL].
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_ws2812_write(
+                            const uint32_t                         pixel,
+                            const led_ws2812_pixel_t *const      p_color,
+                            const uint32_t                          duty
+                                    );
+
+/**
+ * @brief encode the pixels changed since the last call and send them as
+ *        soon as the frame on the wire is done.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_ws2812_flush(void);
+
+/**
+ * @brief end of a transfer, called by HAL_SPI_TxCpltCallback() of any SPI.
+ *
+ * @param[in] hspi        : The SPI which is done.
+ *
+ * */
+void system_led_ws2812_tx_cplt(SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief init SPI1, its DMA stream and the data pin, every pixel is off.
+ *
+ * @return led_status_t : Status of the function.
+ *
+ * */
+led_status_t system_led_ws2812_init(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_LED_WS2812_H__
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_time_base.c
+ *
+ * @par dependencies
+ * - system_time_base.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief microsecond time base on the DWT cycle counter of the Cortex-M4.
+ *
+ * Processing flow:
+ *
+ * A read is a few instructions with the interrupts masked, so the tick
+ * ISR and the threads never fold the same cycles twice.
+ *
+ * @version V1.0 2025-05-28
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "system_time_base.h"
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define __TIME_BASE_US_PER_S          (1000000U)
+#define __TIME_BASE_MS_PER_MM         (60000U)
+
+/* CYCCNT at the last read                                                 */
+static uint32_t time_base_cyccnt        = 0;
+/* Cycles not folded into a whole microsecond yet                          */
+static uint32_t time_base_cycles        = 0;
+/* Time base[us]                                                           */
+static uint32_t time_base_now_us        = 0;
+/* Core cycles per microsecond, 0 until the counter is started             */
+static uint32_t time_base_cycles_per_us = 0;
+
+/**
+ * @brief  fold the cycles elapsed since the last read into the time base.
+ * @retval Time base[us].
+ */
+static uint32_t __time_base_fold(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t cyccnt  = 0;
+    uint32_t us      = 0;
+
+    __disable_irq();
+    cyccnt                  = DWT->CYCCNT;
+    time_base_cycles       += cyccnt - time_base_cyccnt;
+    time_base_cyccnt        = cyccnt;
+    // one division per read, the remainder is kept for the next one.
+    us                      = time_base_cycles / time_base_cycles_per_us;
+    time_base_cycles       -= us * time_base_cycles_per_us;
+    time_base_now_us       += us;
+    us                      = time_base_now_us;
+    __set_PRIMASK(primask);
+
+    return us;
+}
+
+/**
+ * @brief start the cycle counter, it is never reset afterwards.
+ *
+ * @return uint32_t : Core cycles per microsecond, 0 if the clock is not
+ *                    a whole number of MHz.
+ *
+ * */
+uint32_t system_time_base_init(void)
+{
+    DEBUG_OUT("Info: Enter system_time_base_init!\r\n");
+
+    if ( 0 != SystemCoreClock % __TIME_BASE_US_PER_S )
+    {
+        DEBUG_OUT("Error: The core clock is not a whole MHz!\r\n");
+        return 0;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |=     DWT_CTRL_CYCCNTENA_Msk;
+
+    time_base_cyccnt        =                               DWT->CYCCNT;
+    time_base_cycles        =                                         0;
+    time_base_now_us        =                   HAL_GetTick() * LED_US_PER_MS;
+    time_base_cycles_per_us = SystemCoreClock / __TIME_BASE_US_PER_S;
+
+    return time_base_cycles_per_us;
+}
+
+/**
+ * @brief fold the elapsed cycles into the time base, called from the HAL
+ *        tick so that CYCCNT never wraps twice between two reads.
+ *
+ * */
+void system_time_base_update(void)
+{
+    if ( 0 != time_base_cycles_per_us )
+    {
+        (void)__time_base_fold();
+    }
+}
+
+/**
+ * @brief get the time base in microseconds, thread and ISR safe.
+ *
+ * @return uint32_t : Time base[us], it wraps every 2^32 us.
+ *
+ * */
+uint32_t system_time_base_us(void)
+{
+    // before init, the HAL tick is the best there is.
+    if ( 0 == time_base_cycles_per_us )
+    {
+        return HAL_GetTick() * LED_US_PER_MS;
+    }
+
+    return __time_base_fold();
+}
+
+/**
+ * @brief get the time base in minutes from the HAL tick.
+ *
+ * @return uint32_t : Time base[minute].
+ *
+ * */
+uint32_t system_time_base_mm(void)
+{
+    return HAL_GetTick() / __TIME_BASE_MS_PER_MM;
+}
+//******************************** Defines **********************************//
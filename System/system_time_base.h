@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright (C) 2024 xxxxxx, Inc.(Gmbh) or its affiliates.
+ *
+ * All Rights Reserved.
+ *
+ * @file system_time_base.h
+ *
+ * @par dependencies
+ * - main.h
+ * - bsp_led_driver.h
+ *
+ * @author ZhuangZhong | R&D Dept. | xxxxxx, Inc.(Gmbh)
+ *
+ * @brief microsecond time base on the DWT cycle counter of the Cortex-M4.
+ *
+ * Processing flow:
+ *
+ * system_time_base_init() -> system_time_base_update() per HAL tick
+ *                         -> system_time_base_us() at any time.
+ *
+ * CYCCNT wraps every 2^32 core cycles, about 43 s at 100 MHz. The cycles
+ * elapsed since the last read are folded into a 32-bit microsecond count,
+ * so the time base is right as long as it is read once per wrap, which
+ * the 1 ms HAL tick guarantees. The microsecond count itself wraps every
+ * 71 minutes, the engine compares it with LED_TIME_BEFORE.
+ *
+ * @version V1.0 2025-05-28
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __SYSTEM_TIME_BASE_H__
+#define __SYSTEM_TIME_BASE_H__
+
+//******************************** Includes *********************************//
+
+#include "main.h"
+
+#include "bsp_led_driver.h"
+//******************************** Includes *********************************//
+
+//******************************** Declaring ********************************//
+
+/**
+ * @brief start the cycle counter, it is never reset afterwards.
+ *
+ * @return uint32_t : Core cycles per microsecond, 0 if the clock is not
+ *                    a whole number of MHz.
+ *
+ * */
+uint32_t system_time_base_init(void);
+
+/**
+ * @brief fold the elapsed cycles into the time base, called from the HAL
+ *        tick so that CYCCNT never wraps twice between two reads.
+ *
+ * */
+void system_time_base_update(void);
+
+/**
+ * @brief get the time base in microseconds, thread and ISR safe.
+ *
+ * @return uint32_t : Time base[us], it wraps every 2^32 us.
+ *
+ * */
+uint32_t system_time_base_us(void);
+
+/**
+ * @brief get the time base in minutes from the HAL tick.
+ *
+ * @return uint32_t : Time base[minute].
+ *
+ * */
+uint32_t system_time_base_mm(void);
+//******************************** Declaring ********************************//
+#endif // End of __SYSTEM_TIME_BASE_H__